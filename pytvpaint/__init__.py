@@ -1,4 +1,4 @@
-"""PyTVPaint package logger."""
+"""PyTVPaint package logger and session helpers."""
 
 from __future__ import annotations
 
@@ -43,3 +43,8 @@ def _get_logger() -> logging.Logger:
 
 
 log = _get_logger()
+
+# Imported after the logger is defined since the george modules use it
+from pytvpaint.george.client import connect as connect  # noqa: E402
+from pytvpaint.george.client.cache import cached as cached  # noqa: E402
+from pytvpaint.george.client.metrics import profile as profile  # noqa: E402
@@ -2,10 +2,11 @@
 
 from __future__ import annotations
 
-from collections.abc import Iterator
+from collections.abc import Iterator, Sequence
 from typing import TYPE_CHECKING
 
-from pytvpaint import george, utils
+from pytvpaint import george
+from pytvpaint.george.client.cache import snapshot_cache
 from pytvpaint.utils import (
     Refreshable,
     Removable,
@@ -31,9 +32,9 @@ class Camera(Refreshable):
 
     def refresh(self) -> None:
         """Refreshed the camera data."""
-        if not self.refresh_on_call and self._data:
-            return
-        self._data = george.tv_camera_info_get()
+        self._data = snapshot_cache.get(
+            ("camera", self._clip.id), george.tv_camera_info_get
+        )
 
     def __repr__(self) -> str:
         """String representation of the camera."""
@@ -134,12 +135,19 @@ class Camera(Refreshable):
 
     @property
     @set_as_current
+    def points_data(self) -> list[george.TVPCameraPoint]:
+        """The values of all the points of the camera path, fetched in a single George call.
+
+        They are stored in the snapshot cache, use `pytvpaint.cached` to fetch them once for many reads.
+        """
+        return snapshot_cache.get(
+            ("camera_points", self._clip.id), george.tv_camera_enum_points_all
+        )
+
+    @property
     def points(self) -> Iterator[CameraPoint]:
         """Iterator for the `CameraPoint` objects of the camera."""
-        points_data = utils.position_generator(
-            lambda pos: george.tv_camera_enum_points(pos)
-        )
-        for index, point_data in enumerate(points_data):
+        for index, point_data in enumerate(self.points_data):
             yield CameraPoint(index, camera=self, data=point_data)
 
     @set_as_current
@@ -148,14 +156,26 @@ class Camera(Refreshable):
         position = max(0.0, min(position, 1.0))
         return george.tv_camera_interpolation(position)
 
+    @set_as_current
+    def sample(self, positions: Sequence[float]) -> list[george.TVPCameraPoint]:
+        """Get the points data interpolated at several positions (between 0 and 1) in a single George call.
+
+        Example:
+            ```python
+            # the camera at each frame of the clip
+            count = clip.duration
+            samples = clip.camera.sample([i / max(count - 1, 1) for i in range(count)])
+            ```
+        """
+        positions = [max(0.0, min(position, 1.0)) for position in positions]
+        return george.tv_camera_interpolation_list(positions)
+
     @set_as_current
     def remove_point(self, index: int) -> None:
         """Remove a point at that index."""
-        try:
-            point = next(p for i, p in enumerate(self.points) if i == index)
-            point.remove()
-        except StopIteration:
-            pass
+        points_data = self.points_data
+        if 0 <= index < len(points_data):
+            CameraPoint(index, camera=self, data=points_data[index]).remove()
 
 
 class CameraPoint(Removable):
@@ -178,9 +198,11 @@ class CameraPoint(Removable):
     def refresh(self) -> None:
         """Refreshed the camera point data."""
         super().refresh()
-        if not self.refresh_on_call and self._data:
-            return
-        self._data = george.tv_camera_enum_points(self._index)
+        self._data = snapshot_cache.get(
+            ("camera_point", self.camera.clip.id, self._index),
+            george.tv_camera_enum_points,
+            self._index,
+        )
 
     def __repr__(self) -> str:
         """String representation of the camera point."""
@@ -2,7 +2,7 @@
 
 from __future__ import annotations
 
-from collections.abc import Iterator
+from collections.abc import Iterable, Iterator
 from pathlib import Path
 from typing import TYPE_CHECKING
 
@@ -10,6 +10,7 @@ from fileseq.filesequence import FileSequence
 
 from pytvpaint import george, utils
 from pytvpaint.camera import Camera
+from pytvpaint.george.client.cache import snapshot_cache
 from pytvpaint.layer import Layer, LayerColor
 from pytvpaint.sound import ClipSound
 from pytvpaint.utils import (
@@ -31,22 +32,31 @@ class Clip(Removable, Renderable):
         self,
         clip_id: int,
         project: Project | None = None,
+        validate: bool = False,
     ) -> None:
         """Constructs a Clip from an existing TVPaint clip (giving its id).
 
+        The clip data is fetched when it's first read, unless `validate` is True.
+
         Note:
             You should use `Clip.new` to create a new clip
 
         Args:
             clip_id: an existing clip id
             project: the project or the current one if None
+            validate: fetch the data right away, to check that the clip exists. Defaults to False.
+
+        Raises:
+            NoObjectWithIdError: if `validate` is True and there's no clip with that id
         """
         from pytvpaint.project import Project
 
         super().__init__()
         self._id = clip_id
         self._project = project or Project.current_project()
-        self._data = george.tv_clip_info(self.id)
+        self._data: george.TVPClip
+        if validate:
+            self._data = george.tv_clip_info(self.id)
 
     def __repr__(self) -> str:
         """The string representation of the clip."""
@@ -91,9 +101,9 @@ class Clip(Removable, Renderable):
     def refresh(self) -> None:
         """Refreshes the clip data."""
         super().refresh()
-        if not self.refresh_on_call and self._data:
-            return
-        self._data = george.tv_clip_info(self._id)
+        self._data = snapshot_cache.get(
+            ("clip", self._id), george.tv_clip_info, self._id
+        )
 
     def make_current(self) -> None:
         """Make the clip the current one."""
@@ -118,12 +128,12 @@ class Clip(Removable, Renderable):
         Raises:
             ValueError: if clip cannot be found in the project
         """
-        for scene in self.project.scenes:
-            for other_clip in scene.clips:
-                if other_clip == self:
-                    self.make_current()
-                    return scene
-        raise Exception("The clip's scene doesn't exist")
+        from pytvpaint.scene import Scene
+
+        project = self.project
+        scene_id = project.index.clip_scene_id(self.id)
+        self.make_current()
+        return Scene(scene_id, project)
 
     @scene.setter
     def scene(self, value: Scene) -> None:
@@ -142,10 +152,7 @@ class Clip(Removable, Renderable):
         Raises:
             ValueError: if clip cannot be found in the project
         """
-        for pos, clip_id in enumerate(self.scene.clip_ids):
-            if clip_id == self.id:
-                return pos
-        raise ValueError(f"No clip found open with id : {self.id}")
+        return self.project.index.clip_position(self.id)
 
     @position.setter
     def position(self, value: int) -> None:
@@ -334,11 +341,60 @@ class Clip(Removable, Renderable):
         for layer_id in self.layer_ids:
             yield Layer(layer_id, clip=self)
 
+    def layers_snapshot(self) -> list[Layer]:
+        """Get all the clip's layers with their data fetched in a single George call.
+
+        It's much faster than iterating over `Clip.layers` on clips with many layers.
+        """
+        layers = []
+        for data in george.tv_layer_info_all(self.id):
+            snapshot_cache.put(("layer", data.id), data)
+            layers.append(Layer(data.id, clip=self, data=data))
+        return layers
+
+    def set_layers(
+        self,
+        layers: Iterable[Layer | int],
+        is_visible: bool | None = None,
+        is_locked: bool | None = None,
+        is_selected: bool | None = None,
+        color: LayerColor | None = None,
+    ) -> None:
+        """Set the visibility, lock, selection and color of several layers in a single batch request.
+
+        Example:
+            ```python
+            # hide all the layers except the current one
+            others = [layer for layer in clip.layers_snapshot() if not layer.is_current]
+            clip.set_layers(others, is_visible=False)
+            ```
+
+        Args:
+            layers: the layers or layer ids
+            is_visible: show or hide the layers, unchanged if None. Defaults to None.
+            is_locked: lock or unlock the layers, unchanged if None. Defaults to None.
+            is_selected: select or deselect the layers, unchanged if None. Defaults to None.
+            color: the layer color, unchanged if None. Defaults to None.
+
+        Raises:
+            GeorgeError: if one of the layers doesn't exist, the other layers are still changed
+        """
+        layer_ids = [
+            layer.id if isinstance(layer, Layer) else layer for layer in layers
+        ]
+        george.tv_layers_set(
+            layer_ids,
+            visible=is_visible,
+            locked=is_locked,
+            selected=is_selected,
+            color_index=color.index if color else None,
+        )
+
     @property
     @set_as_current
     def layer_names(self) -> Iterator[str]:
-        """Iterator over the clip's layer names."""
-        for layer in self.layers:
+        """Iterator over the clip's layer names, the layers data is fetched in a single George call."""
+        for layer in self.layers_snapshot():
             yield layer.name
 
     @property
@@ -358,8 +414,9 @@ class Clip(Removable, Renderable):
         by_id: int | None = None,
         by_name: str | None = None,
     ) -> Layer | None:
-        """Get a specific layer by id or name."""
-        return utils.get_tvp_element(self.layers, by_id, by_name)
+        """Get a specific layer by id or name, the layers data is fetched in a single George call."""
+        with snapshot_cache.freeze():
+            return utils.get_tvp_element(iter(self.layers_snapshot()), by_id, by_name)
 
     @set_as_current
     def add_layer(self, layer_name: str) -> Layer:
@@ -460,6 +517,7 @@ class Clip(Removable, Renderable):
         alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
         background_mode: george.BackgroundMode | None = None,
         format_opts: list[str] | None = None,
+        incremental: bool = False,
     ) -> None:
         """Render the clip to a single frame or frame sequence or movie.
 
@@ -472,10 +530,13 @@ class Clip(Removable, Renderable):
             alpha_mode: the alpha mode for rendering. Defaults to george.AlphaSaveMode.PREMULTIPLY.
             background_mode: the background mode for rendering. Defaults to None.
             format_opts: custom format options. Defaults to None.
+            incremental: only render the frames of an image sequence whose inputs changed since the last
+                render, see `pytvpaint.render.render_incremental`. Defaults to False.
 
         Raises:
             ValueError: if requested range (start-end) not in clip range/bounds
             ValueError: if output is a movie, and it's duration is equal to 1 frame
+            ValueError: if the render is incremental and the output is a movie
             FileNotFoundError: if the render failed and no files were found on disk or missing frames
 
         Note:
@@ -487,6 +548,22 @@ class Clip(Removable, Renderable):
             Even tough pytvpaint does a pretty good job of correcting the frame ranges for rendering, we're still
             encountering some weird edge cases where TVPaint will consider the range invalid for seemingly no reason.
         """
+        if incremental:
+            from pytvpaint.render import render_incremental
+
+            render_incremental(
+                self,
+                output_path,
+                start,
+                end,
+                use_camera,
+                layer_selection=layer_selection,
+                alpha_mode=alpha_mode,
+                background_mode=background_mode,
+                format_opts=format_opts,
+            )
+            return
+
         default_start = self.mark_in or self.start
         default_end = self.mark_out or self.end
 
@@ -839,9 +916,12 @@ class Clip(Removable, Renderable):
 
     @property
     def layer_colors(self) -> Iterator[LayerColor]:
-        """Iterator over the layer colors."""
-        for color_index in range(26):
-            yield LayerColor(color_index=color_index, clip=self)
+        """Iterator over the layer colors, they are fetched in a single George call."""
+        colors = snapshot_cache.get(
+            ("layer_colors", self.id), george.tv_layer_colors_get, self.id
+        )
+        for data in colors:
+            yield LayerColor(data.color_index, clip=self, data=data)
 
     def set_layer_color(self, layer_color: LayerColor) -> None:
         """Set the layer color at the provided index.
@@ -863,19 +943,43 @@ class Clip(Removable, Renderable):
         Raises:
             ValueError: if none of the arguments `by_index` and `by_name` where provided
         """
-        if not by_index and by_name:
+        if by_index is None and by_name is None:
             raise ValueError(
                 "At least one value (by_index or by_name) must be provided"
             )
 
         if by_index is not None:
-            return next(c for i, c in enumerate(self.layer_colors) if i == by_index)
+            return LayerColor(by_index, self)
 
         try:
             return next(c for c in self.layer_colors if c.name == by_name)
         except StopIteration:
             return None
 
+    @property
+    def marks(self) -> Iterator[tuple[Layer, int, LayerColor]]:
+        """Iterator over the marks of all the clip's layers.
+
+        The layers, their marks and the clip colors are fetched in three George calls.
+
+        Yields:
+            layer (Layer): the layer with the mark
+            frame (int): the mark frame
+            color (LayerColor): the mark color
+        """
+        with snapshot_cache.freeze():
+            layers = {layer.id: layer for layer in self.layers_snapshot()}
+            start_frame = self.project.start_frame
+            layer_ranges = [
+                (layer.id, layer.start - start_frame, layer.end - start_frame)
+                for layer in layers.values()
+            ]
+        marks = george.tv_layer_marks_enum(layer_ranges)
+
+        colors = list(self.layer_colors) if marks else []
+        for layer_id, frame, color_index in marks:
+            yield (layers[layer_id], frame + start_frame, colors[color_index])
+
     @property
     def bookmarks(self) -> Iterator[int]:
         """Iterator over the clip bookmarks."""
@@ -911,13 +1015,9 @@ class Clip(Removable, Renderable):
 
     @property
     def sounds(self) -> Iterator[ClipSound]:
-        """Iterates through the clip's soundtracks."""
-        sounds_data = utils.position_generator(
-            lambda pos: george.tv_sound_clip_info(self.id, pos)
-        )
-
-        for track_index, _ in enumerate(sounds_data):
-            yield ClipSound(track_index, clip=self)
+        """Iterates through the clip's soundtracks, their data is fetched in a single George call."""
+        for track_index, data in enumerate(ClipSound.iter_sounds_data(self.id)):
+            yield ClipSound(track_index, clip=self, data=data)
 
     def get_sound(
         self,
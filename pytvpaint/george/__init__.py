@@ -10,3 +10,8 @@ from pytvpaint.george.grg_clip import *  # noqa: F403
 from pytvpaint.george.grg_layer import *  # noqa: F403
 from pytvpaint.george.grg_project import *  # noqa: F403
 from pytvpaint.george.grg_scene import *  # noqa: F403
+
+from pytvpaint.george.client import GeorgeBatch as GeorgeBatch
+from pytvpaint.george.client import GeorgeProgram as GeorgeProgram
+from pytvpaint.george.client import batch as batch
+from pytvpaint.george.client import send_cmds as send_cmds
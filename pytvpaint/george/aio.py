@@ -0,0 +1,148 @@
+"""Awaitable versions of the most used George commands, they are sent with `async_send_cmd`.
+
+The results are parsed with the same `from_result` parsers and raise the same exceptions as their synchronous
+counterpart, but they bypass the snapshot cache: each call is sent to the client of the current context.
+
+Example:
+    ```python
+    from pytvpaint.george import aio
+    from pytvpaint.george.client.aio import create_async_client, use_async_client
+
+    async def current_layer_name(port: int) -> str:
+        async with await create_async_client(port=port) as client:
+            with use_async_client(client):
+                layer_id = await aio.tv_layer_current_id()
+                return (await aio.tv_layer_info(layer_id)).name
+    ```
+"""
+
+from __future__ import annotations
+
+from typing import Any
+
+from pytvpaint.george.client import try_cmd
+from pytvpaint.george.client.aio import async_send_cmd
+from pytvpaint.george.client.parse import tv_cast_to_type
+from pytvpaint.george.exceptions import NoObjectWithIdError
+from pytvpaint.george.grg_base import GrgErrorValue
+from pytvpaint.george.grg_clip import TVPClip
+from pytvpaint.george.grg_layer import TVPLayer
+from pytvpaint.george.grg_project import TVPProject
+
+
+async def tv_project_current_id() -> str:
+    """Get the id of the current project."""
+    return await async_send_cmd("tv_ProjectCurrentId")
+
+
+@try_cmd(
+    raise_exc=NoObjectWithIdError,
+    exception_msg="Invalid project id",
+)
+async def tv_project_info(project_id: str) -> TVPProject:
+    """Get info of the given project.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid project id
+    """
+    result = await async_send_cmd(
+        "tv_ProjectInfo", project_id, error_values=[GrgErrorValue.EMPTY]
+    )
+    return TVPProject.from_result(project_id, result)
+
+
+async def tv_clip_current_id() -> int:
+    """Get the id of the current clip."""
+    return int(await async_send_cmd("tv_ClipCurrentId"))
+
+
+@try_cmd(
+    raise_exc=NoObjectWithIdError,
+    exception_msg="Invalid clip id",
+)
+async def tv_clip_info(clip_id: int) -> TVPClip:
+    """Get the information of the given clip.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid clip id
+    """
+    result = await async_send_cmd(
+        "tv_ClipInfo", clip_id, error_values=[GrgErrorValue.EMPTY]
+    )
+    return TVPClip.from_result(clip_id, result)
+
+
+async def tv_layer_current_id() -> int:
+    """Get the id of the current layer."""
+    return int(await async_send_cmd("tv_LayerCurrentId"))
+
+
+@try_cmd(exception_msg="No layer at provided position")
+async def tv_layer_get_id(position: int) -> int:
+    """Get the id of the layer at the given position.
+
+    Raises:
+        GeorgeError: if no layer found at the provided position
+    """
+    result = await async_send_cmd(
+        "tv_LayerGetID", position, error_values=[GrgErrorValue.NONE]
+    )
+    return int(result)
+
+
+@try_cmd(
+    raise_exc=NoObjectWithIdError,
+    exception_msg="Invalid layer id",
+)
+async def tv_layer_info(layer_id: int) -> TVPLayer:
+    """Get information of the given layer.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid layer id
+    """
+    result = await async_send_cmd(
+        "tv_LayerInfo", layer_id, error_values=[GrgErrorValue.EMPTY]
+    )
+    return TVPLayer.from_result(layer_id, result)
+
+
+@try_cmd(
+    raise_exc=NoObjectWithIdError,
+    exception_msg="Invalid layer id",
+)
+async def tv_layer_display_get(layer_id: int) -> bool:
+    """Get the visibility of the given layer.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid layer id
+    """
+    res = await async_send_cmd("tv_LayerDisplay", layer_id, error_values=[0])
+    return tv_cast_to_type(res.lower(), bool)
+
+
+@try_cmd(
+    raise_exc=NoObjectWithIdError,
+    exception_msg="Invalid layer id",
+)
+async def tv_layer_display_set(
+    layer_id: int, new_state: bool, light_table: bool = False
+) -> None:
+    """Set the visibility of the given layer.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid layer id
+    """
+    args: list[Any] = [layer_id, int(new_state)]
+    if light_table:
+        args.insert(1, "lighttable")
+    await async_send_cmd("tv_LayerDisplay", *args, error_values=[0])
+
+
+async def tv_layer_image_get() -> int:
+    """Get the current frame of the current clip."""
+    return int(await async_send_cmd("tv_LayerGetImage"))
+
+
+async def tv_layer_image(frame: int) -> None:
+    """Set the current frame of the current clip."""
+    await async_send_cmd("tv_LayerImage", frame)
@@ -1,4 +1,4 @@
-"""This modules handles the WebSocket client and automatically connect to the server running in TVPaint.
+"""This modules handles the WebSocket client which connects to the server running in TVPaint on the first command.
 
 It also has crucial functions like `send_cmd` that send George commands and get the result.
 """
@@ -7,62 +7,200 @@ from __future__ import annotations
 
 import contextlib
 import functools
+import inspect
 import os
 import re
+import tempfile
+import threading
+from collections.abc import Iterable, Iterator
+from concurrent import futures
+from concurrent.futures import Future
+from contextvars import ContextVar
 from pathlib import Path
-from time import sleep, time
+from time import monotonic, sleep, time
 from typing import Any, Callable, TypeVar, cast
 
 from pytvpaint import log
-from pytvpaint.george.client.parse import tv_handle_string
-from pytvpaint.george.client.rpc import JSONRPCClient
+from pytvpaint.george.client import metrics
+from pytvpaint.george.client.parse import DeferredResult, tv_handle_string
+from pytvpaint.george.client.rpc import (
+    JSONRPCClient,
+    JSONRPCResponse,
+    backoff_delays,
+)
 from pytvpaint.george.exceptions import GeorgeError
 
 
+def create_client(
+    host: str = "ws://localhost",
+    port: int = 3000,
+    timeout: int = 60,
+    connect: bool = True,
+    heartbeat: float = 1,
+) -> JSONRPCClient:
+    """Create a client for the TVPaint instance listening on the given port.
+
+    The connection is retried with an exponential backoff, so a TVPaint instance that's starting up is
+    reached as soon as it listens.
+
+    Args:
+        host: the WebSocket host. Defaults to "ws://localhost".
+        port: the port of the TVPaint instance. Defaults to 3000.
+        timeout: the time in seconds to wait for the connection, 0 to retry forever. Defaults to 60.
+        connect: whether to connect the client right away. Defaults to True.
+        heartbeat: the interval in seconds between two pings, 0 disables the heartbeat. Defaults to 1.
+
+    Raises:
+        ConnectionRefusedError: if the connection could not be established before the timeout
+
+    Returns:
+        the client
+    """
+    client = JSONRPCClient(f"{host}:{port}", timeout, heartbeat=heartbeat)
+
+    if not connect:
+        return client
+
+    start_time = time()
+
+    for delay in backoff_delays():
+        with contextlib.suppress(ConnectionRefusedError):
+            client.connect()
+            break
+
+        remaining = timeout - (time() - start_time) if timeout else delay
+        if remaining <= 0:
+            # Connection could not be established after timeout
+            client.disconnect()
+            raise ConnectionRefusedError(
+                "Could not establish connection with a tvpaint instance before timeout !"
+            )
+
+        log.warning(f"Connection refused, trying again in {delay:.2f} seconds...")
+        sleep(min(delay, remaining))
+
+    log.info(f"Connected to TVPaint on port {port}")
+
+    return client
+
+
 def _connect_client(
     host: str = "ws://localhost", port: int = 3000, timeout: int = 60
 ) -> JSONRPCClient:
     host = os.getenv("PYTVPAINT_WS_HOST", host)
     port = int(os.getenv("PYTVPAINT_WS_PORT", port))
-    startup_connect = bool(int(os.getenv("PYTVPAINT_WS_STARTUP_CONNECT", 1)))
     timeout = int(os.getenv("PYTVPAINT_WS_TIMEOUT", timeout))
+    heartbeat = float(os.getenv("PYTVPAINT_WS_HEARTBEAT", 1))
 
-    rpc_client = JSONRPCClient(f"{host}:{port}", timeout)
+    return create_client(host, port, timeout, heartbeat=heartbeat)
 
-    if not startup_connect:
-        return rpc_client
 
-    start_time = time()
-    wait_duration = 5
-    connection_successful = False
+_default_client: JSONRPCClient | None = None
+_default_client_lock = threading.Lock()
 
-    while True:
-        if timeout and (time() - start_time) > timeout:
-            break
-        with contextlib.suppress(ConnectionRefusedError):
-            rpc_client.connect()
-            connection_successful = True
-            break
+_context_client: ContextVar[JSONRPCClient | None] = ContextVar(
+    "_context_client", default=None
+)
 
-        log.warning(f"Connection refused, trying again in {wait_duration} seconds...")
-        sleep(wait_duration)
 
-    if not connection_successful:
-        # Connection could not be established after timeout
-        if rpc_client.is_connected:
-            rpc_client.disconnect()
+def get_default_client() -> JSONRPCClient:
+    """Get the default client, it connects to TVPaint on the first call.
 
-        raise ConnectionRefusedError(
-            "Could not establish connection with a tvpaint instance before timeout !"
-        )
+    The connection is configured with the `PYTVPAINT_WS_*` environment variables.
+
+    Raises:
+        ConnectionRefusedError: if the connection could not be established before the timeout
+    """
+    global _default_client
+
+    with _default_client_lock:
+        if _default_client is None:
+            _default_client = _connect_client()
+        return _default_client
+
+
+def set_default_client(client: JSONRPCClient | None) -> None:
+    """Replace the default client, None creates a new one on the next command."""
+    global _default_client
+
+    with _default_client_lock:
+        _default_client = client
+
+
+def context_client() -> JSONRPCClient | None:
+    """Get the client set with `use_client` in the current context, None if it's the default one."""
+    return _context_client.get()
+
+
+def get_client() -> JSONRPCClient:
+    """Get the client that sends the George commands in the current context.
 
-    if connection_successful:
-        log.info(f"Connected to TVPaint on port {port}")
+    It's the client set with `use_client` or the default client.
+    """
+    return _context_client.get() or get_default_client()
+
+
+@contextlib.contextmanager
+def use_client(client: JSONRPCClient) -> Iterator[JSONRPCClient]:
+    """Context manager that sends the George commands to another TVPaint instance.
+
+    The client is local to the context, so each thread can drive its own instance.
+
+    Example:
+        ```python
+        with use_client(create_client(port=3001)):
+            print(Project.current_project().name)
+        ```
+
+    Yields:
+        the client
+    """
+    token = _context_client.set(client)
+    try:
+        yield client
+    finally:
+        _context_client.reset(token)
 
-    return rpc_client
 
+@contextlib.contextmanager
+def connect(
+    host: str = "ws://localhost", port: int = 3000, timeout: int = 60
+) -> Iterator[JSONRPCClient]:
+    """Context manager that connects to a TVPaint instance and sends the George commands of the context to it.
+
+    The client is disconnected when exiting the context.
+
+    Example:
+        ```python
+        with pytvpaint.connect(port=3001):
+            print(Project.current_project().name)
+        ```
+
+    Args:
+        host: the WebSocket host. Defaults to "ws://localhost".
+        port: the port of the TVPaint instance. Defaults to 3000.
+        timeout: the time in seconds to wait for the connection. Defaults to 60.
+
+    Raises:
+        ConnectionRefusedError: if the connection could not be established before the timeout
+
+    Yields:
+        the connected client
+    """
+    client = create_client(host, port, timeout)
+    try:
+        with use_client(client):
+            yield client
+    finally:
+        client.disconnect()
+
+
+def __getattr__(name: str) -> Any:
+    """Lazy access to the default client with `rpc_client`, kept for compatibility."""
+    if name == "rpc_client":
+        return get_default_client()
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
 
-rpc_client = _connect_client()
 
 T = TypeVar("T", bound=Callable[..., Any])
 
@@ -74,7 +212,7 @@ def try_cmd(
 ) -> Callable[[T], T]:
     """Decorator that does a try/except with GeorgeError by default.
 
-    It raises the error with the custom exception message provided.
+    It raises the error with the custom exception message provided, coroutine functions are supported.
 
     Args:
         raise_exc: the exception to raise. Defaults to GeorgeError.
@@ -86,6 +224,17 @@ def try_cmd(
     """
 
     def decorate(func: T) -> T:
+        if inspect.iscoroutinefunction(func):
+
+            @functools.wraps(func)
+            async def async_applicator(*args: Any, **kwargs: Any) -> Any:
+                try:
+                    return await func(*args, **kwargs)
+                except catch_exc as e:
+                    raise raise_exc(exception_msg or e)
+
+            return cast(T, async_applicator)
+
         @functools.wraps(func)
         def applicator(*args: Any, **kwargs: Any) -> Any:
             try:
@@ -98,6 +247,115 @@ def try_cmd(
     return decorate
 
 
+def _format_cmd(command: str, args: tuple[Any, ...], handle_string: bool) -> str:
+    """Build the George command string sent to TVPaint."""
+    if not args:
+        return command
+    if handle_string:
+        tv_args = [
+            tv_handle_string(arg) if isinstance(arg, str) else str(arg) for arg in args
+        ]
+    else:
+        tv_args = [str(arg) for arg in args]
+    return f"{command} {' '.join(tv_args)}"
+
+
+_UNDO_STACK_COMMANDS = frozenset(
+    ["tv_UndoOpenStack", "tv_UpdateUndo", "tv_UndoCloseStack"]
+)
+
+
+def _is_undo_stack(command: str) -> bool:
+    """Returns True if the command is an undo stack command, those are not logged."""
+    return command in _UNDO_STACK_COMMANDS
+
+
+_ERROR_RESULT = re.compile(r"ERROR -?\d+", re.IGNORECASE)
+
+
+def _check_result(result: str, error_values: list[Any] | None = None) -> str:
+    """Raise a GeorgeError if the George result is an error value.
+
+    Raises:
+        GeorgeError: if we received `ERROR XX` or any of the custom error codes
+    """
+    # Test for basic ERROR X values and user provided custom errors
+    res_in_error_values = error_values and result in {str(v) for v in error_values}
+    if res_in_error_values or _ERROR_RESULT.match(result):
+        msg = f"Received value: '{result}' considered as an error"
+        raise GeorgeError(msg, error_value=result)
+
+    return result
+
+
+def send_cmd_future(
+    command: str,
+    *args: Any,
+    error_values: list[Any] | None = None,
+    handle_string: bool = True,
+) -> Future[str]:
+    """Send a George command to TVPaint without waiting for the result.
+
+    Commands are pipelined so many of them can be in flight at the same time, which saves a
+    round trip per command. They are still executed by TVPaint in the order they were sent.
+
+    Args:
+        command: the George command to send
+        *args: pass any arguments you want to that function
+        error_values: a list of error values to catch from George. Defaults to None.
+        handle_string: control the quote wrapping of string with spaces. Defaults to True.
+
+    Returns:
+        a future resolved with the George return string or a GeorgeError
+    """
+    cmd_str = _format_cmd(command, args, handle_string)
+    log_cmd = not _is_undo_stack(command)
+
+    if log_cmd:
+        log.debug("[RPC] >> %s", cmd_str)
+
+    current_batch = _current_batch.get()
+    if current_batch is not None:
+        return current_batch.add(cmd_str, error_values, log_result=log_cmd)
+
+    future: Future[str] = Future()
+    # The response is received by the reader thread, out of the `profile` contexts
+    collectors = metrics.active_collectors()
+    start_time = monotonic() if collectors else None
+
+    def _on_response(response: Future[JSONRPCResponse]) -> None:
+        if future.cancelled():
+            return
+        result = ""
+        try:
+            result = response.result()["result"]
+            if log_cmd:
+                log.debug("[RPC] << %s", result)
+            future.set_result(_check_result(result, error_values))
+        except Exception as e:
+            future.set_exception(e)
+        finally:
+            if start_time is not None:
+                metrics.record(
+                    command,
+                    monotonic() - start_time,
+                    len(cmd_str),
+                    len(result),
+                    error=future.exception() is not None,
+                    collectors=collectors,
+                )
+
+    def _on_done(done: Future[str]) -> None:
+        # Cancelling the result (see `JSONRPCClient.wait`) forgets the request
+        if done.cancelled():
+            response.cancel()
+
+    response = get_client().submit_remote("execute_george", [cmd_str])
+    response.add_done_callback(_on_response)
+    future.add_done_callback(_on_done)
+    return future
+
+
 def send_cmd(
     command: str,
     *args: Any,
@@ -108,6 +366,10 @@ def send_cmd(
 
     Catch basic `ERROR XX` errors returned from George, but you can provide your own error values.
 
+    Note:
+        Inside a `batch` context the command is deferred and an empty `DeferredResult` is returned,
+        casting or parsing it raises a RuntimeError.
+
     Args:
         command: the George command to send
         *args: pass any arguments you want to that function
@@ -120,34 +382,197 @@ def send_cmd(
     Returns:
         the George return string
     """
-    tv_args = [
-        tv_handle_string(arg) if handle_string and isinstance(arg, str) else arg
-        for arg in args
-    ]
-    cmd_str = " ".join([str(arg) for arg in [command, *tv_args]])
+    future = send_cmd_future(
+        command, *args, error_values=error_values, handle_string=handle_string
+    )
+    if _current_batch.get() is not None:
+        return DeferredResult(command)
+    return get_client().wait(future)
+
+
+class GeorgeBatch:
+    """George commands collected by `batch` and sent to TVPaint in a single request."""
+
+    def __init__(self) -> None:
+        self._commands: list[tuple[str, list[Any] | None, bool, Future[str]]] = []
+        self.results: list[str] = []
+
+    def __len__(self) -> int:
+        """The number of commands waiting to be sent."""
+        return len(self._commands)
+
+    def add(
+        self,
+        cmd_str: str,
+        error_values: list[Any] | None = None,
+        log_result: bool = True,
+    ) -> Future[str]:
+        """Add a formatted George command to the batch.
+
+        Returns:
+            a future resolved with the George return string when the batch is flushed
+        """
+        future: Future[str] = Future()
+        self._commands.append((cmd_str, error_values, log_result, future))
+        return future
+
+    def discard(self) -> None:
+        """Cancel the commands waiting to be sent."""
+        for *_, future in self._commands:
+            future.cancel()
+        self._commands.clear()
+
+    def flush(self) -> list[str]:
+        """Send the collected commands as one JSON-RPC batch request and wait for the results.
+
+        All the commands are executed by TVPaint, even if some of them return an error value.
+
+        Raises:
+            GeorgeError: the first error returned by one of the commands
+            TimeoutError: if some responses were not received before the client timeout
+
+        Returns:
+            the George return strings in the order of the commands
+        """
+        commands, self._commands = self._commands, []
+        if not commands:
+            return []
+
+        client = get_client()
+        start_time = monotonic()
+        responses = client.submit_remote_batch(
+            [("execute_george", [cmd_str]) for cmd_str, *_ in commands]
+        )
 
-    is_undo_stack = command in [
-        "tv_UndoOpenStack",
-        "tv_UpdateUndo",
-        "tv_UndoCloseStack",
-    ]
+        _, not_done = futures.wait(responses, timeout=client.timeout or None)
+        for response in not_done:
+            response.cancel()
 
-    if not is_undo_stack:
-        log.debug(f"[RPC] >> {cmd_str}")
+        # The commands share the round trip, so each one gets an equal part of it
+        duration = (monotonic() - start_time) / len(commands)
 
-    response = rpc_client.execute_remote("execute_george", [cmd_str])
-    result = response["result"]
+        self.results = []
+        first_error: Exception | None = None
 
-    if not is_undo_stack:
-        log.debug(f"[RPC] << {result}")
+        for (cmd_str, error_values, log_result, future), response in zip(
+            commands, responses
+        ):
+            result = ""
+            try:
+                if response.cancelled():
+                    raise TimeoutError(
+                        f"No response from {client.url} after {client.timeout} seconds"
+                    )
+                result = response.result()["result"]
+                if log_result:
+                    log.debug("[RPC] << %s", result)
+                self.results.append(result)
+                future.set_result(_check_result(result, error_values))
+            except Exception as e:
+                future.set_exception(e)
+                first_error = first_error or e
+
+            if metrics.is_recording():
+                metrics.record(
+                    cmd_str.split(" ", 1)[0],
+                    duration,
+                    len(cmd_str),
+                    len(result),
+                    error=future.exception() is not None,
+                    collectors=collectors,
+                )
+
+        if first_error:
+            raise first_error
+
+        return self.results
+
+
+_current_batch: ContextVar[GeorgeBatch | None] = ContextVar(
+    "_current_batch", default=None
+)
+
+
+@contextlib.contextmanager
+def batch() -> Iterator[GeorgeBatch]:
+    """Context manager that sends the George commands to TVPaint in a single batch request.
+
+    Every `send_cmd` done in the context is deferred and returns an empty string. The commands
+    are sent in one WebSocket frame when exiting the context, so only use it with functions that
+    don't read the result (setters): the functions that cast or parse it raise a RuntimeError.
+    Use `send_cmd_future` to get the result of a deferred command.
+
+    Nested batches are merged with the outer one. If an exception is raised in the context,
+    the collected commands are not sent.
 
-    # Test for basic ERROR X values and user provided custom errors
-    res_in_error_values = error_values and result in list(map(str, error_values))
-    if res_in_error_values or re.match(r"ERROR -?\d+", result, re.IGNORECASE):
-        msg = f"Received value: '{result}' considered as an error"
-        raise GeorgeError(msg, error_value=result)
+    Raises:
+        GeorgeError: the first error returned by one of the commands
 
-    return result
+    Yields:
+        the batch collecting the commands
+    """
+    current_batch = _current_batch.get()
+    if current_batch is not None:
+        yield current_batch
+        return
+
+    new_batch = GeorgeBatch()
+    token = _current_batch.set(new_batch)
+
+    try:
+        yield new_batch
+    except BaseException:
+        new_batch.discard()
+        raise
+    finally:
+        _current_batch.reset(token)
+
+    new_batch.flush()
+
+
+def send_cmds(
+    commands: Iterable[tuple[Any, ...]],
+    error_values: list[Any] | None = None,
+    handle_string: bool = True,
+) -> list[str]:
+    """Send multiple George commands to TVPaint in a single batch request.
+
+    Args:
+        commands: the George commands, each one is a tuple with the command name followed by its arguments
+        error_values: a list of error values to catch from George. Defaults to None.
+        handle_string: control the quote wrapping of string with spaces. Defaults to True.
+
+    Raises:
+        GeorgeError: the first error returned by one of the commands
+
+    Returns:
+        the George return strings in the order of the commands
+    """
+    commands_batch = GeorgeBatch()
+    for command, *args in commands:
+        cmd_str = _format_cmd(command, tuple(args), handle_string)
+        log.debug("[RPC] >> %s", cmd_str)
+        commands_batch.add(cmd_str, error_values)
+
+    with _outside_batch():
+        return commands_batch.flush()
+
+
+@contextlib.contextmanager
+def _outside_batch() -> Iterator[None]:
+    """Send the commands deferred by a running batch and execute the next ones right away."""
+    current_batch = _current_batch.get()
+    if current_batch is None:
+        yield
+        return
+
+    # Keep the execution order with the commands deferred by the batch
+    current_batch.flush()
+    token = _current_batch.set(None)
+    try:
+        yield
+    finally:
+        _current_batch.reset(token)
 
 
 def run_script(script: Path | str) -> None:
@@ -163,3 +588,219 @@ def run_script(script: Path | str) -> None:
     if not script.exists():
         raise ValueError(f"Script not found at : {script.as_posix()}")
     send_cmd("tv_RunScript", script.as_posix())
+
+
+def run_inline_script(source: str) -> list[str]:
+    """Execute George source code in a single call and get the lines it wrote as a result.
+
+    The source is saved in a temporary .grg file executed with `run_script`. To return values,
+    the script writes lines to the file path stored in the `pytvpaint_output` variable, like this:
+    `tv_WriteTextFile "append" pytvpaint_output value`.
+
+    Note:
+        TVPaint must have access to the temporary directory of the Python process.
+
+    Args:
+        source: the George source code
+
+    Returns:
+        the lines written in the output file
+    """
+    with tempfile.TemporaryDirectory(prefix="pytvpaint_") as tmp_dir:
+        script = Path(tmp_dir, "script.grg")
+        output = Path(tmp_dir, "output.txt")
+
+        header = f'pytvpaint_output = "{output.as_posix()}"'
+        script.write_text(f"{header}\n{source}", encoding="utf-8")
+
+        with _outside_batch():
+            run_script(script)
+
+        if not output.exists():
+            return []
+        return output.read_text(encoding="utf-8").splitlines()
+
+
+class GeorgeVariable(str):
+    """A George variable or expression passed as is (never quoted) to a `GeorgeProgram` command."""
+
+
+# The George variable written by `GeorgeProgram.run_checked` and its value when no command failed
+_STATUS_VARIABLE = "pytvpaint_status"
+_STATUS_OK = "status ok"
+
+
+class GeorgeProgram:
+    """Builder of a George script that runs a compound operation in a single call.
+
+    Each command is formatted like in `send_cmd`, the `result` George variable holds the return value of the
+    last command. Use `write` to return values, they are the lines returned by `run`.
+
+    Use `check` after the commands that may fail and `run_checked` to raise a `GeorgeError` when one of
+    them returned an `ERROR XX` value, the commands after a failing one are skipped.
+
+    Example:
+        ```python
+        program = GeorgeProgram()
+        program.cmd("tv_LayerCreate", "temp").assign("temp_id", "result")
+        program.cmd("tv_LayerKill", GeorgeProgram.var("temp_id"))
+        program.write("temp_id")
+        temp_id = int(program.run()[0])
+        ```
+    """
+
+    def __init__(self) -> None:
+        """Initialize an empty program."""
+        self._lines: list[str] = []
+        self._indent = 0
+        self._last_command = ""
+        self._checks = 0
+        self._checked = False
+
+    @staticmethod
+    def var(name: str) -> GeorgeVariable:
+        """Reference a George variable (or expression) in the arguments of `cmd`."""
+        return GeorgeVariable(name)
+
+    def _add(self, line: str) -> GeorgeProgram:
+        self._lines.append("    " * self._indent + line)
+        return self
+
+    def cmd(
+        self, command: str, *args: Any, handle_string: bool = True
+    ) -> GeorgeProgram:
+        """Add a George command with the provided arguments.
+
+        Args:
+            command: the George command
+            *args: the command arguments, use `var` to pass a George variable
+            handle_string: control the quote wrapping of string with spaces. Defaults to True.
+
+        Returns:
+            the program
+        """
+        tv_args = [
+            tv_handle_string(arg)
+            if handle_string
+            and isinstance(arg, str)
+            and not isinstance(arg, GeorgeVariable)
+            else arg
+            for arg in args
+        ]
+        self._last_command = command
+        return self._add(" ".join([str(arg) for arg in [command, *tv_args]]))
+
+    def assign(self, name: str, expression: Any) -> GeorgeProgram:
+        """Assign a value or an expression (like `result`) to a George variable."""
+        return self._add(f"{name} = {expression}")
+
+    def write(self, expression: str) -> GeorgeProgram:
+        """Write the value of a George expression as a line of the result."""
+        return self._add(f'tv_WriteTextFile "append" pytvpaint_output {expression}')
+
+    def raw(self, source: str) -> GeorgeProgram:
+        """Add George source code as is."""
+        for line in source.strip("\n").splitlines():
+            self._add(line)
+        return self
+
+    @contextlib.contextmanager
+    def block(self, header: str) -> Iterator[GeorgeProgram]:
+        """Context manager that adds an `IF`, `WHILE` or `FOR` block closed by `END`.
+
+        Args:
+            header: the block statement, like `IF next_frame > frame`
+
+        Yields:
+            the program
+        """
+        self._add(header)
+        self._indent += 1
+        try:
+            yield self
+        finally:
+            self._indent -= 1
+            self._add("END")
+
+    def check(self, step: str | None = None) -> GeorgeProgram:
+        """Only run the next commands if the last one didn't return an `ERROR XX` value.
+
+        The failing step and its result are written by `run_checked` as the status line of the program.
+
+        Args:
+            step: the name of the step in the error message, the last command if None. Defaults to None.
+
+        Returns:
+            the program
+        """
+        self._init_status()
+
+        step = step or self._last_command
+        self._add(f"PARSE result {_STATUS_VARIABLE}_error {_STATUS_VARIABLE}_code")
+        self._add(f'IF CMP({_STATUS_VARIABLE}_error, "ERROR") == 1')
+        self._add(f'    {_STATUS_VARIABLE} = CONCAT("status {step} ", result)')
+        self._add("ELSE")
+        self._indent += 1
+        self._checks += 1
+        return self
+
+    @contextlib.contextmanager
+    def checks(self) -> Iterator[GeorgeProgram]:
+        """Context manager that ends the checks made in it, the commands after it run even if one failed.
+
+        Yields:
+            the program
+        """
+        checks = self._checks
+        try:
+            yield self
+        finally:
+            self._end_checks(checks)
+
+    def _init_status(self) -> None:
+        if not self._checked:
+            self._lines.insert(0, f'{_STATUS_VARIABLE} = "{_STATUS_OK}"')
+            self._checked = True
+
+    def _end_checks(self, checks: int = 0) -> None:
+        while self._checks > checks:
+            self._checks -= 1
+            self._indent -= 1
+            self._add("END")
+
+    @property
+    def source(self) -> str:
+        """The George source code of the program."""
+        return "\n".join(self._lines)
+
+    def run(self) -> list[str]:
+        """Execute the program with `run_inline_script` and get the lines it wrote."""
+        return run_inline_script(self.source)
+
+    def run_checked(self) -> list[str]:
+        """Execute the program and check the status line written after the commands, see `check`.
+
+        Raises:
+            GeorgeError: if the status line is missing (the script stopped) or if a checked command failed
+
+        Returns:
+            the lines written before the status line
+        """
+        self._init_status()
+
+        self._end_checks()
+        self.write(_STATUS_VARIABLE)
+        *lines, status = self.run() or [""]
+
+        if status == _STATUS_OK:
+            return lines
+        if not status.startswith("status "):
+            raise GeorgeError("The George program stopped before writing its status")
+
+        step, _, result = status.removeprefix("status ").partition(" ")
+        msg = f"George command {step} failed: '{result}'"
+        raise GeorgeError(msg, error_value=result)
+
+
+if bool(int(os.getenv("PYTVPAINT_WS_STARTUP_CONNECT", 0))):
+    get_default_client()
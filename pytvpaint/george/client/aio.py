@@ -0,0 +1,570 @@
+"""Asyncio JSON-RPC client and `async_send_cmd`, to drive TVPaint instances from an event loop.
+
+The client speaks the WebSocket protocol over asyncio streams: there's no thread per connection, a reader task
+resolves the pending requests. The George results are checked and parsed like with `send_cmd`. The protocol is
+implemented here since websocket-client, used by the sync client, has no asyncio API.
+
+Example:
+    ```python
+    async def main() -> None:
+        async with await create_async_client(port=3000) as client:
+            with use_async_client(client):
+                print(await async_send_cmd("tv_Version"))
+    ```
+"""
+
+from __future__ import annotations
+
+import asyncio
+import base64
+import contextlib
+import hashlib
+import os
+import struct
+from collections.abc import Awaitable, Iterable, Iterator
+from contextvars import ContextVar
+from time import monotonic
+from types import TracebackType
+from typing import Any, TypeVar, cast
+from urllib.parse import urlsplit
+
+from pytvpaint import log
+from pytvpaint.george.client import _check_result, _format_cmd, _is_undo_stack, metrics
+from pytvpaint.george.client.rpc import (
+    JSONRPCPayload,
+    JSONRPCResponse,
+    JSONRPCResponseError,
+    JSONValueType,
+    backoff_delays,
+    json_dumps,
+    json_loads,
+)
+
+T = TypeVar("T")
+
+_WEBSOCKET_GUID = b"258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+_OPCODE_CONTINUATION = 0x0
+_OPCODE_TEXT = 0x1
+_OPCODE_CLOSE = 0x8
+_OPCODE_PING = 0x9
+_OPCODE_PONG = 0xA
+
+
+def _mask(payload: bytes, key: bytes) -> bytes:
+    """Mask (or unmask) a WebSocket payload with a 4 bytes key."""
+    length = len(payload)
+    repeated_key = (key * (length // 4 + 1))[:length]
+    masked = int.from_bytes(payload, "big") ^ int.from_bytes(repeated_key, "big")
+    return masked.to_bytes(length, "big")
+
+
+class AsyncJSONRPCClient:
+    """JSON-RPC 2.0 client over WebSockets for asyncio.
+
+    Requests are pipelined like with `JSONRPCClient`: they are written without waiting for the previous responses and
+    the reader task matches each response to its request by id. A lost connection fails the pending requests and the
+    next request reconnects.
+    """
+
+    def __init__(self, url: str, timeout: float = 60, version: str = "2.0") -> None:
+        """Initialize a new JSON-RPC client with a WebSocket url endpoint.
+
+        Args:
+            url: the WebSocket url endpoint, like `ws://localhost:3000`
+            timeout: the time in seconds to wait for the connection or a response, 0 to wait forever. Defaults to 60.
+            version: The JSON-RPC version. Defaults to "2.0".
+        """
+        self.url = url
+        self.timeout = timeout
+        self.jsonrpc_version = version
+        self.rpc_id = 0
+
+        self._reader: asyncio.StreamReader | None = None
+        self._writer: asyncio.StreamWriter | None = None
+        self._reader_task: asyncio.Task[None] | None = None
+        self._pending: dict[int, asyncio.Future[JSONRPCResponse]] = {}
+        self._connect_lock: asyncio.Lock | None = None
+        self._write_lock: asyncio.Lock | None = None
+
+    async def __aenter__(self) -> AsyncJSONRPCClient:
+        """Connect to the server."""
+        await self.connect()
+        return self
+
+    async def __aexit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_value: BaseException | None,
+        traceback: TracebackType | None,
+    ) -> None:
+        """Disconnect from the server."""
+        await self.disconnect()
+
+    @property
+    def is_connected(self) -> bool:
+        """Returns True if the client is connected."""
+        return (
+            self._writer is not None
+            and not self._writer.is_closing()
+            and self._reader_task is not None
+            and not self._reader_task.done()
+        )
+
+    async def connect(self) -> None:
+        """Connects to the WebSocket endpoint, concurrent calls share the same connection attempt.
+
+        Raises:
+            ConnectionRefusedError: if the server refused the connection or the handshake failed
+        """
+        # The lock is created here so that it belongs to the running event loop
+        if self._connect_lock is None:
+            self._connect_lock = asyncio.Lock()
+
+        async with self._connect_lock:
+            if self.is_connected:
+                return
+
+            url = urlsplit(self.url)
+            try:
+                reader, writer = await asyncio.wait_for(
+                    asyncio.open_connection(url.hostname, url.port or 80),
+                    self.timeout or None,
+                )
+                self._reader, self._writer = reader, writer
+                await self._handshake(reader, writer, url.hostname or "", url.path)
+            except (OSError, asyncio.TimeoutError, ConnectionError) as e:
+                await self._close_transport()
+                raise ConnectionRefusedError(f"Can't connect to {self.url}: {e}")
+
+            reader_coro = self._read_responses(reader, writer)
+            self._reader_task = asyncio.create_task(reader_coro)
+
+    async def disconnect(self) -> None:
+        """Disconnects from the server and fails the pending requests."""
+        # Stop reading first, the reader would answer the close frame of the server
+        if self._reader_task:
+            self._reader_task.cancel()
+            with contextlib.suppress(asyncio.CancelledError):
+                await self._reader_task
+            self._reader_task = None
+
+        if self._writer and not self._writer.is_closing():
+            with contextlib.suppress(OSError, ConnectionError):
+                await self._write(self._writer, _OPCODE_CLOSE, struct.pack("!H", 1000))
+        await self._close_transport()
+
+        self._fail_pending(ConnectionError(f"Disconnected from {self.url}"))
+
+    async def _close_transport(self) -> None:
+        """Close the socket."""
+        if self._writer:
+            self._writer.close()
+            with contextlib.suppress(OSError, ConnectionError):
+                await self._writer.wait_closed()
+        self._reader, self._writer = None, None
+
+    @staticmethod
+    async def _handshake(
+        reader: asyncio.StreamReader,
+        writer: asyncio.StreamWriter,
+        host: str,
+        path: str,
+    ) -> None:
+        """Upgrade the connection to the WebSocket protocol."""
+        key = base64.b64encode(os.urandom(16))
+        writer.write(
+            f"GET {path or '/'} HTTP/1.1\r\n"
+            f"Host: {host}\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            f"Sec-WebSocket-Key: {key.decode()}\r\n"
+            "Sec-WebSocket-Version: 13\r\n\r\n".encode()
+        )
+        await writer.drain()
+
+        response = await reader.readuntil(b"\r\n\r\n")
+        expected = base64.b64encode(hashlib.sha1(key + _WEBSOCKET_GUID).digest())
+        if b" 101 " not in response.split(b"\r\n", 1)[0] or expected not in response:
+            raise ConnectionError("The server refused the WebSocket upgrade")
+
+    @staticmethod
+    def _frame(opcode: int, payload: bytes) -> bytes:
+        """Build a masked frame, the client frames must be masked."""
+        length = len(payload)
+        if length < 126:
+            header = struct.pack("!BB", 0x80 | opcode, 0x80 | length)
+        elif length < 1 << 16:
+            header = struct.pack("!BBH", 0x80 | opcode, 0x80 | 126, length)
+        else:
+            header = struct.pack("!BBQ", 0x80 | opcode, 0x80 | 127, length)
+        key = os.urandom(4)
+        return header + key + _mask(payload, key)
+
+    async def _write(
+        self, writer: asyncio.StreamWriter, opcode: int, payload: bytes
+    ) -> None:
+        """Write a frame and wait until it's sent, concurrent writes wait for each other.
+
+        Older Python versions don't support concurrent calls to `StreamWriter.drain`.
+        """
+        # Created lazily like the connection lock, for the running event loop
+        if self._write_lock is None:
+            self._write_lock = asyncio.Lock()
+
+        async with self._write_lock:
+            writer.write(self._frame(opcode, payload))
+            await writer.drain()
+
+    async def _read_message(
+        self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter
+    ) -> bytes | None:
+        """Read the next text message, answering the pings. Returns None if the server closed the connection."""
+        fragments: list[bytes] = []
+
+        while True:
+            first, second = await reader.readexactly(2)
+            fin, opcode, length = first & 0x80, first & 0x0F, second & 0x7F
+            if length == 126:
+                (length,) = struct.unpack("!H", await reader.readexactly(2))
+            elif length == 127:
+                (length,) = struct.unpack("!Q", await reader.readexactly(8))
+
+            key = await reader.readexactly(4) if second & 0x80 else None
+            payload = await reader.readexactly(length)
+            if key:
+                payload = _mask(payload, key)
+
+            if opcode == _OPCODE_CLOSE:
+                # Echo the status code to complete the closing handshake
+                with contextlib.suppress(OSError, ConnectionError):
+                    await self._write(writer, _OPCODE_CLOSE, payload[:2])
+                return None
+            if opcode == _OPCODE_PING:
+                await self._write(writer, _OPCODE_PONG, payload)
+                continue
+            if opcode in (_OPCODE_TEXT, _OPCODE_CONTINUATION):
+                fragments.append(payload)
+                if fin:
+                    return b"".join(fragments)
+
+    async def _read_responses(
+        self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter
+    ) -> None:
+        """Receive the responses and resolve the matching pending requests until the connection is lost."""
+        try:
+            while True:
+                message = await self._read_message(reader, writer)
+                if message is None:
+                    break
+                self._handle_message(message)
+        except (asyncio.IncompleteReadError, OSError, ConnectionError) as e:
+            log.warning(f"Connection to {self.url} lost: {e}")
+        finally:
+            writer.close()
+            self._fail_pending(ConnectionError(f"Connection to {self.url} lost"))
+
+    def _handle_message(self, message: bytes) -> None:
+        """Decode a message and dispatch its responses, an invalid message is logged and skipped."""
+        try:
+            data = json_loads(message.decode("utf-8"))
+        except (ValueError, UnicodeDecodeError) as e:
+            log.warning(f"Received an invalid JSON-RPC message from {self.url}: {e}")
+            return
+
+        # Batch requests are answered with an array of responses
+        for response in data if isinstance(data, list) else [data]:
+            if not isinstance(response, dict):
+                log.warning(f"Received an invalid JSON-RPC response: {response!r}")
+                continue
+            self._dispatch_response(cast(JSONRPCResponse, response))
+
+    def _dispatch_response(self, response: JSONRPCResponse) -> None:
+        """Resolve the pending request matching the response id."""
+        response_id = response.get("id")
+        if response_id is None and "error" in response:
+            # The server couldn't read the request id (parse error or invalid request)
+            self._fail_pending(JSONRPCResponseError(response["error"]))
+            return
+
+        future = self._pending.pop(cast(int, response_id), None)
+        if not future or future.done():
+            log.warning(f"Received a response for an unknown request: {response}")
+            return
+
+        if "error" in response:
+            future.set_exception(JSONRPCResponseError(response["error"]))
+        else:
+            future.set_result(response)
+
+    def _fail_pending(self, exc: Exception) -> None:
+        """Fail all the requests that are still waiting for a response."""
+        pending, self._pending = self._pending, {}
+        for future in pending.values():
+            if not future.done():
+                future.set_exception(exc)
+
+    def _payload(
+        self, method: str, params: list[JSONValueType] | None
+    ) -> tuple[JSONRPCPayload, asyncio.Future[JSONRPCResponse]]:
+        """Build a request payload and register its future."""
+        payload: JSONRPCPayload = {
+            "jsonrpc": self.jsonrpc_version,
+            "id": self.rpc_id,
+            "method": method,
+            "params": params or [],
+        }
+        future: asyncio.Future[JSONRPCResponse] = (
+            asyncio.get_running_loop().create_future()
+        )
+        self._pending[payload["id"]] = future
+        self.rpc_id = (self.rpc_id + 1) % (1 << 63)
+        return payload, future
+
+    async def _send(self, message: Any) -> None:
+        """Write a JSON message, it reconnects first if the connection was lost."""
+        if not self.is_connected:
+            await self.connect()
+
+        writer = self._writer
+        if writer is None:
+            raise ConnectionError(f"The client is not connected to {self.url}")
+        await self._write(writer, _OPCODE_TEXT, json_dumps(message).encode())
+
+    async def _wait(self, request_ids: list[int], responses: Awaitable[T]) -> T:
+        """Wait for the responses for at most the client timeout, the requests are then forgotten.
+
+        Raises:
+            TimeoutError: if there's no response before the timeout
+        """
+        try:
+            return await asyncio.wait_for(responses, self.timeout or None)
+        except asyncio.TimeoutError:
+            raise TimeoutError(
+                f"No response from {self.url} after {self.timeout} seconds"
+            ) from None
+        finally:
+            # A late response is ignored by the reader
+            for request_id in request_ids:
+                self._pending.pop(request_id, None)
+
+    async def execute_remote(
+        self,
+        method: str,
+        params: list[JSONValueType] | None = None,
+    ) -> JSONRPCResponse:
+        """Executes a remote procedure call and waits for the response.
+
+        Args:
+            method: the name of the method to be invoked
+            params: the parameter values to be used during the invocation of the method. Defaults to None.
+
+        Raises:
+            ConnectionError: if the connection is lost before the response
+            TimeoutError: if there's no response before the timeout
+            JSONRPCResponseError: if there was an error server-side
+
+        Returns:
+            JSONRPCResponse: the JSON-RPC response payload
+        """
+        payload, future = self._payload(method, params)
+        try:
+            await self._send(payload)
+        except BaseException:
+            self._pending.pop(payload["id"], None)
+            raise
+        return await self._wait([payload["id"]], future)
+
+    async def execute_remote_batch(
+        self,
+        calls: list[tuple[str, list[JSONValueType] | None]],
+    ) -> list[JSONRPCResponse | Exception]:
+        """Executes multiple remote procedure calls in a single batch request.
+
+        See: https://www.jsonrpc.org/specification#batch
+
+        Args:
+            calls: the (method, params) of each request
+
+        Raises:
+            ConnectionError: if the connection is lost before the responses
+            TimeoutError: if some responses were not received before the timeout
+
+        Returns:
+            the response payload or the `JSONRPCResponseError` of each request, in the same order as the calls
+        """
+        if not calls:
+            return []
+
+        requests = [self._payload(method, params) for method, params in calls]
+        try:
+            await self._send([payload for payload, _ in requests])
+        except BaseException:
+            for payload, _ in requests:
+                self._pending.pop(payload["id"], None)
+            raise
+
+        responses = await self._wait(
+            [payload["id"] for payload, _ in requests],
+            asyncio.gather(*(future for _, future in requests), return_exceptions=True),
+        )
+
+        results: list[JSONRPCResponse | Exception] = []
+        for response in responses:
+            if isinstance(response, JSONRPCResponseError):
+                results.append(response)
+            elif isinstance(response, BaseException):
+                raise response
+            else:
+                results.append(response)
+        return results
+
+
+async def create_async_client(
+    host: str = "ws://localhost",
+    port: int = 3000,
+    timeout: float = 60,
+) -> AsyncJSONRPCClient:
+    """Create a client for the TVPaint instance listening on the given port and connect it.
+
+    Args:
+        host: the WebSocket host. Defaults to "ws://localhost".
+        port: the port of the TVPaint instance. Defaults to 3000.
+        timeout: the time in seconds to wait for the connection, 0 to retry forever. Defaults to 60.
+
+    Raises:
+        ConnectionRefusedError: if the connection could not be established before the timeout
+
+    Returns:
+        the connected client
+    """
+    client = AsyncJSONRPCClient(f"{host}:{port}", timeout)
+    start_time = monotonic()
+
+    for delay in backoff_delays():
+        try:
+            await client.connect()
+            break
+        except ConnectionRefusedError:
+            remaining = timeout - (monotonic() - start_time) if timeout else delay
+            if remaining <= 0:
+                raise
+        log.warning(f"Connection refused, trying again in {delay:.2f} seconds...")
+        await asyncio.sleep(min(delay, remaining))
+
+    log.info(f"Connected to TVPaint on port {port}")
+    return client
+
+
+_async_client: ContextVar[AsyncJSONRPCClient | None] = ContextVar(
+    "_async_client", default=None
+)
+
+
+def get_async_client() -> AsyncJSONRPCClient:
+    """Get the client set with `use_async_client` in the current context.
+
+    Raises:
+        RuntimeError: if there's no client in the current context
+    """
+    client = _async_client.get()
+    if client is None:
+        raise RuntimeError(
+            "No async client in this context, set one with `use_async_client`"
+        )
+    return client
+
+
+@contextlib.contextmanager
+def use_async_client(client: AsyncJSONRPCClient) -> Iterator[AsyncJSONRPCClient]:
+    """Context manager that sends the George commands of `async_send_cmd` to that client.
+
+    The client is local to the context, so each task can drive its own instance.
+
+    Yields:
+        the client
+    """
+    token = _async_client.set(client)
+    try:
+        yield client
+    finally:
+        _async_client.reset(token)
+
+
+async def async_send_cmd(
+    command: str,
+    *args: Any,
+    error_values: list[Any] | None = None,
+    handle_string: bool = True,
+) -> str:
+    """Send a George command with the provided arguments to TVPaint, like `send_cmd` for asyncio.
+
+    Args:
+        command: the George command to send
+        *args: pass any arguments you want to that function
+        error_values: a list of error values to catch from George. Defaults to None.
+        handle_string: control the quote wrapping of string with spaces. Defaults to True.
+
+    Raises:
+        GeorgeError: if we received `ERROR XX` or any of the custom error codes
+
+    Returns:
+        the George return string
+    """
+    cmd_str = _format_cmd(command, args, handle_string)
+    log_cmd = not _is_undo_stack(command)
+    if log_cmd:
+        log.debug("[RPC] >> %s", cmd_str)
+
+    start_time = monotonic() if metrics.is_recording() else None
+    result = ""
+    error = True
+    try:
+        response = await get_async_client().execute_remote("execute_george", [cmd_str])
+        result = response["result"]
+        if log_cmd:
+            log.debug("[RPC] << %s", result)
+        checked = _check_result(result, error_values)
+        error = False
+        return checked
+    finally:
+        if start_time is not None:
+            duration = monotonic() - start_time
+            metrics.record(command, duration, len(cmd_str), len(result), error)
+
+
+async def async_send_cmds(
+    commands: Iterable[tuple[Any, ...]],
+    error_values: list[Any] | None = None,
+    handle_string: bool = True,
+) -> list[str]:
+    """Send multiple George commands to TVPaint in a single batch request, like `send_cmds` for asyncio.
+
+    Args:
+        commands: the George commands, each one is a tuple with the command name followed by its arguments
+        error_values: a list of error values to catch from George. Defaults to None.
+        handle_string: control the quote wrapping of string with spaces. Defaults to True.
+
+    Raises:
+        GeorgeError: the first error returned by one of the commands, all of them are still executed
+        JSONRPCResponseError: the first server-side error
+
+    Returns:
+        the George return strings in the order of the commands
+    """
+    cmd_strs = [
+        _format_cmd(command, tuple(args), handle_string) for command, *args in commands
+    ]
+    for cmd_str in cmd_strs:
+        log.debug("[RPC] >> %s", cmd_str)
+
+    responses = await get_async_client().execute_remote_batch(
+        [("execute_george", [cmd_str]) for cmd_str in cmd_strs]
+    )
+
+    results: list[str] = []
+    for response in responses:
+        if isinstance(response, Exception):
+            raise response
+        results.append(_check_result(response["result"], error_values))
+    return results
@@ -0,0 +1,222 @@
+"""Session snapshot cache of the data read from TVPaint (layers, clips, projects, ...).
+
+The data is keyed by element type and id and is invalidated each time a mutating George function
+is called. By default the data expires right away, so it's always fetched from TVPaint, unless
+you read it in a `cached` context or set the `PYTVPAINT_CACHE_TTL` environment variable.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import functools
+import os
+from collections.abc import Hashable, Iterator
+from contextvars import ContextVar
+from time import monotonic
+from typing import Any, Callable, TypeVar, cast
+
+from pytvpaint.george.client import context_client
+
+T = TypeVar("T")
+F = TypeVar("F", bound=Callable[..., Any])
+
+
+class SnapshotCache:
+    """Cache of the data of TVPaint elements, keyed by element type and id.
+
+    Each call of a George function decorated with `mutates` increments the generation and
+    clears the cache. Outside a `cached` context, entries also expire after `ttl` seconds.
+    The keys are scoped by client since the ids are specific to each TVPaint instance.
+    """
+
+    def __init__(self, ttl: float = 0.0) -> None:
+        """Initialize an empty cache.
+
+        Args:
+            ttl: the time in seconds after which cached data expires. Defaults to 0.
+        """
+        self.ttl = ttl
+        self.generation = 0
+        # The timestamp is None for the data kept until the next mutation
+        self._entries: dict[Hashable, tuple[int, float | None, Any]] = {}
+        self._frozen: ContextVar[int] = ContextVar("_frozen", default=0)
+
+    @property
+    def is_frozen(self) -> bool:
+        """Returns True if we're in a `cached` context, data doesn't expire."""
+        return self._frozen.get() > 0
+
+    def _is_valid(self, entry: tuple[int, float | None, Any]) -> bool:
+        generation, timestamp, _ = entry
+        if generation != self.generation:
+            return False
+        if timestamp is None or self.is_frozen:
+            return True
+        return (monotonic() - timestamp) < self.ttl
+
+    @staticmethod
+    def _scoped(key: Hashable) -> Hashable:
+        return context_client(), key
+
+    def get(
+        self,
+        key: Hashable,
+        fetch: Callable[..., T],
+        *args: Any,
+        until_mutation: bool = False,
+    ) -> T:
+        """Get the cached data or fetch it from TVPaint if it's missing or stale.
+
+        Args:
+            key: the element key, for example `("layer", layer_id)`
+            fetch: the function that gets the data from TVPaint
+            *args: the arguments passed to the fetch function
+            until_mutation: keep the data until the next mutation, whatever the TTL. Defaults to False.
+
+        Returns:
+            the element data
+        """
+        entry = self._entries.get(self._scoped(key))
+        if entry and self._is_valid(entry):
+            return cast(T, entry[2])
+
+        value = fetch(*args)
+        self.put(key, value, until_mutation)
+        return value
+
+    def put(self, key: Hashable, value: Any, until_mutation: bool = False) -> None:
+        """Store fresh data in the cache (for example fetched in bulk).
+
+        Args:
+            key: the element key, for example `("layer", layer_id)`
+            value: the element data
+            until_mutation: keep the data until the next mutation, whatever the TTL. Defaults to False.
+        """
+        if until_mutation:
+            self._entries[self._scoped(key)] = (self.generation, None, value)
+        elif self.is_frozen or self.ttl > 0:
+            self._entries[self._scoped(key)] = (self.generation, monotonic(), value)
+
+    def invalidate(self, key: Hashable | None = None) -> None:
+        """Invalidate a single entry or the whole cache if no key is given."""
+        if key is not None:
+            self._entries.pop(self._scoped(key), None)
+            return
+
+        self.generation += 1
+        self._entries.clear()
+
+    @contextlib.contextmanager
+    def freeze(self) -> Iterator[SnapshotCache]:
+        """Context manager in which the cached data doesn't expire."""
+        token = self._frozen.set(self._frozen.get() + 1)
+        try:
+            yield self
+        finally:
+            self._frozen.reset(token)
+
+
+snapshot_cache = SnapshotCache(ttl=float(os.getenv("PYTVPAINT_CACHE_TTL", 0)))
+
+
+def cached() -> contextlib.AbstractContextManager[SnapshotCache]:
+    """Context manager that freezes the data read from TVPaint, useful to scan a project.
+
+    Each object is fetched once, the cache is still invalidated by the George functions that
+    modify TVPaint data, but not by changes made by the user in the TVPaint UI.
+
+    Example:
+        ```python
+        with pytvpaint.cached():
+            for layer in clip.layers:
+                print(layer.name, layer.start, layer.end)  # only one tv_LayerInfo per layer
+        ```
+    """
+    return snapshot_cache.freeze()
+
+
+def mutates(func: F) -> F:
+    """Decorator for George functions that modify TVPaint data, it invalidates the snapshot cache.
+
+    Returns:
+        the decorated function
+    """
+
+    @functools.wraps(func)
+    def applicator(*args: Any, **kwargs: Any) -> Any:
+        try:
+            return func(*args, **kwargs)
+        finally:
+            snapshot_cache.invalidate()
+
+    return cast(F, applicator)
+
+
+def current(kind: str, fetch: Callable[[], T]) -> T:
+    """Get the tracked current project, scene, clip, layer id or frame or fetch it from TVPaint.
+
+    The current context is stored in the snapshot cache. A value set by a George setter (see
+    `sets_current`) is kept until the next mutating function, whatever the TTL. A value fetched
+    from TVPaint follows the cache policy (reused in a `cached` context) since the user can change
+    it in the TVPaint UI. Like the other cached data, a current element changed from the UI after
+    a setter is only seen after the next mutation.
+
+    Args:
+        kind: the tracked value, like `"clip"` or `"frame"`
+        fetch: the function that gets the value from TVPaint
+
+    Returns:
+        the current value
+    """
+    return snapshot_cache.get(("current", kind), fetch)
+
+
+def sets_current(kind: str) -> Callable[[F], F]:
+    """Decorator for George functions that make their first argument the current value of `kind`.
+
+    It must be applied on top of `mutates` or `changes_current` since the tracked value is
+    stored after the call. The value is kept until the next mutation, even with the default TTL,
+    so setting an element current and then sending commands to it only selects it once.
+
+    Args:
+        kind: the tracked value, like `"clip"` or `"frame"`
+
+    Returns:
+        the decorator
+    """
+
+    def decorate(func: F) -> F:
+        @functools.wraps(func)
+        def applicator(*args: Any, **kwargs: Any) -> Any:
+            res = func(*args, **kwargs)
+            value = args[0] if args else next(iter(kwargs.values()))
+            snapshot_cache.put(("current", kind), value, until_mutation=True)
+            return res
+
+        return cast(F, applicator)
+
+    return decorate
+
+
+def changes_current(*kinds: str) -> Callable[[F], F]:
+    """Decorator for George functions that change the current values of `kinds` (for example the frame).
+
+    Args:
+        *kinds: the tracked values, like `"clip"` or `"frame"`
+
+    Returns:
+        the decorator
+    """
+
+    def decorate(func: F) -> F:
+        @functools.wraps(func)
+        def applicator(*args: Any, **kwargs: Any) -> Any:
+            try:
+                return func(*args, **kwargs)
+            finally:
+                for kind in kinds:
+                    snapshot_cache.invalidate(("current", kind))
+
+        return cast(F, applicator)
+
+    return decorate
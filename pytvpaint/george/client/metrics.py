@@ -0,0 +1,230 @@
+"""Optional metrics of the George commands sent to TVPaint (call counts, latency, bytes and errors).
+
+The metrics are recorded by `send_cmd` when the `PYTVPAINT_METRICS` environment variable is set to 1 or in a
+`profile` context. They can be exported as a dict, as JSON or as Prometheus text.
+"""
+
+from __future__ import annotations
+
+import bisect
+import contextlib
+import json
+import os
+import threading
+from collections.abc import Iterator, Sequence
+from contextvars import ContextVar
+from dataclasses import asdict, dataclass, field
+from typing import Any
+
+# Upper bounds in seconds of the latency histogram buckets
+LATENCY_BUCKETS = (0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 5.0)
+
+
+@dataclass
+class CommandStats:
+    """The metrics of a George command."""
+
+    calls: int = 0
+    errors: int = 0
+    total_time: float = 0.0
+    max_time: float = 0.0
+    bytes_sent: int = 0
+    bytes_received: int = 0
+    # Number of calls in each latency bucket, the last one is for the calls above the last bound
+    histogram: list[int] = field(
+        default_factory=lambda: [0] * (len(LATENCY_BUCKETS) + 1)
+    )
+
+    @property
+    def mean_time(self) -> float:
+        """The average latency of the command in seconds."""
+        return self.total_time / self.calls if self.calls else 0.0
+
+
+class Metrics:
+    """Collects the metrics of the George commands, grouped by command name."""
+
+    def __init__(self, enabled: bool = False) -> None:
+        """Initialize an empty collector.
+
+        Args:
+            enabled: whether the collector records the commands. Defaults to False.
+        """
+        self.enabled = enabled
+        self.commands: dict[str, CommandStats] = {}
+        self._lock = threading.Lock()
+
+    def record(
+        self,
+        command: str,
+        duration: float,
+        bytes_sent: int = 0,
+        bytes_received: int = 0,
+        error: bool = False,
+    ) -> None:
+        """Record a call of a George command.
+
+        Args:
+            command: the George command name, like `tv_LayerInfo`
+            duration: the time in seconds between sending the command and receiving the result
+            bytes_sent: the size of the command string
+            bytes_received: the size of the result string
+            error: whether the command returned an error
+        """
+        with self._lock:
+            stats = self.commands.setdefault(command, CommandStats())
+            stats.calls += 1
+            stats.errors += int(error)
+            stats.total_time += duration
+            stats.max_time = max(stats.max_time, duration)
+            stats.bytes_sent += bytes_sent
+            stats.bytes_received += bytes_received
+            stats.histogram[bisect.bisect_left(LATENCY_BUCKETS, duration)] += 1
+
+    def reset(self) -> None:
+        """Clear all the recorded metrics."""
+        with self._lock:
+            self.commands.clear()
+
+    def top(self, count: int = 10) -> list[tuple[str, CommandStats]]:
+        """Get the commands that took the most total time."""
+        with self._lock:
+            commands = list(self.commands.items())
+        commands.sort(key=lambda item: item[1].total_time, reverse=True)
+        return commands[:count]
+
+    def to_dict(self) -> dict[str, dict[str, Any]]:
+        """Export the metrics of each command as a dict."""
+        with self._lock:
+            return {
+                command: {**asdict(stats), "mean_time": stats.mean_time}
+                for command, stats in self.commands.items()
+            }
+
+    def to_json(self) -> str:
+        """Export the metrics of each command as JSON."""
+        return json.dumps(
+            {"buckets": LATENCY_BUCKETS, "commands": self.to_dict()}, indent=2
+        )
+
+    def to_prometheus(self, prefix: str = "pytvpaint_george") -> str:
+        """Export the metrics in the Prometheus text format.
+
+        Args:
+            prefix: the prefix of the metric names. Defaults to "pytvpaint_george".
+
+        Returns:
+            the metrics as text
+        """
+        with self._lock:
+            commands = sorted(self.commands.items())
+
+        lines: list[str] = []
+        histogram = f"{prefix}_command_duration_seconds"
+        lines.append(f"# HELP {histogram} Latency of the George commands.")
+        lines.append(f"# TYPE {histogram} histogram")
+
+        for command, stats in commands:
+            label = f'command="{command}"'
+            cumulative = 0
+            for bound, bucket_count in zip(LATENCY_BUCKETS, stats.histogram):
+                cumulative += bucket_count
+                bucket = f'{histogram}_bucket{{{label},le="{bound}"}}'
+                lines.append(f"{bucket} {cumulative}")
+            lines.append(f'{histogram}_bucket{{{label},le="+Inf"}} {stats.calls}')
+            lines.append(f"{histogram}_sum{{{label}}} {stats.total_time}")
+            lines.append(f"{histogram}_count{{{label}}} {stats.calls}")
+
+        counters = [
+            ("errors", "Number of George commands that returned an error.", "errors"),
+            ("bytes_sent", "Size of the George commands sent.", "bytes_sent"),
+            ("bytes_received", "Size of the George results.", "bytes_received"),
+        ]
+        for name, description, attribute in counters:
+            counter = f"{prefix}_command_{name}_total"
+            lines.append(f"# HELP {counter} {description}")
+            lines.append(f"# TYPE {counter} counter")
+            for command, stats in commands:
+                value = getattr(stats, attribute)
+                lines.append(f'{counter}{{command="{command}"}} {value}')
+
+        return "\n".join(lines) + "\n"
+
+    def report(self, count: int = 10) -> str:
+        """Format the commands that took the most total time as a table."""
+        columns = ["calls", "errors", "total (s)", "mean (ms)", "max (ms)"]
+        header = f"{'command':<32}" + "".join(f"{column:>12}" for column in columns)
+        lines = [header, "-" * len(header)]
+
+        for command, stats in self.top(count):
+            lines.append(
+                f"{command:<32}{stats.calls:>12}{stats.errors:>12}"
+                f"{stats.total_time:>12.3f}{stats.mean_time * 1000:>12.2f}"
+                f"{stats.max_time * 1000:>12.2f}"
+            )
+
+        return "\n".join(lines)
+
+
+metrics = Metrics(enabled=bool(int(os.getenv("PYTVPAINT_METRICS", 0))))
+
+# The collectors of the `profile` contexts running in the current thread or task, like `use_client`
+_profilers: ContextVar[tuple[Metrics, ...]] = ContextVar("_profilers", default=())
+
+
+def active_collectors() -> list[Metrics]:
+    """Returns the enabled collectors of the current context, the global metrics and the running profilers."""
+    collectors = (metrics, *_profilers.get())
+    return [collector for collector in collectors if collector.enabled]
+
+
+def is_recording() -> bool:
+    """Returns True if the commands must be recorded."""
+    return metrics.enabled or bool(_profilers.get())
+
+
+def record(
+    command: str,
+    duration: float,
+    bytes_sent: int = 0,
+    bytes_received: int = 0,
+    error: bool = False,
+    collectors: Sequence[Metrics] | None = None,
+) -> None:
+    """Record a call of a George command in the global metrics and the running profilers.
+
+    The collectors of the current context are used by default, the ones of a command whose response is
+    received by another thread must be captured with `active_collectors` when it's sent.
+    """
+    if collectors is None:
+        collectors = active_collectors()
+    for collector in collectors:
+        collector.record(command, duration, bytes_sent, bytes_received, error)
+
+
+@contextlib.contextmanager
+def profile(count: int = 10) -> Iterator[Metrics]:
+    """Context manager that records the George commands and prints the ones that took the most total time.
+
+    Only the commands sent by the current thread or asyncio task are recorded.
+
+    Example:
+        ```python
+        with pytvpaint.profile():
+            for layer in clip.layers:
+                print(layer.name)
+        ```
+
+    Args:
+        count: the number of commands to print. Defaults to 10.
+
+    Yields:
+        the metrics recorded in the context
+    """
+    profiler = Metrics(enabled=True)
+    token = _profilers.set((*_profilers.get(), profiler))
+    try:
+        yield profiler
+    finally:
+        _profilers.reset(token)
+        print(profiler.report(count))
@@ -7,12 +7,15 @@ George can either return a list of values or a list of key/value pairs which are
 
 from __future__ import annotations
 
+import functools
 from collections.abc import Sequence
 from dataclasses import Field, fields, is_dataclass
 from enum import Enum
 from typing import (
     Any,
+    Callable,
     ClassVar,
+    NoReturn,
     TypeVar,
     Union,
     cast,
@@ -30,6 +33,32 @@ class DataclassInstance(Protocol):
     __dataclass_fields__: ClassVar[dict[str, Field[Any]]]
 
 
+class DeferredResult(str):
+    """The empty string returned by `send_cmd` for a command deferred in a `batch`.
+
+    The result is only known once the batch is sent, so casting or parsing it raises a RuntimeError
+    instead of failing on an empty value.
+    """
+
+    command: str
+
+    def __new__(cls, command: str) -> DeferredResult:
+        """Construct the deferred result of a George command."""
+        result = super().__new__(cls, "")
+        result.command = command
+        return result
+
+    def unavailable(self, *args: Any, **kwargs: Any) -> NoReturn:
+        """Raise the error of a result read inside a batch."""
+        raise RuntimeError(
+            f"The result of {self.command} can't be read inside a batch, "
+            "call it outside of the batch or use send_cmd_future"
+        )
+
+    __int__ = __float__ = unavailable
+    split = lower = upper = strip = unavailable
+
+
 def tv_handle_string(s: str) -> str:
     """String handling for George arguments. It wraps the string into quotes if it has spaces.
 
@@ -64,35 +93,28 @@ def camel_to_pascal(s: str) -> str:
 
 T = TypeVar("T", bound=Any)
 
+Caster: TypeAlias = Callable[[str], Any]
 
-def tv_cast_to_type(value: str, cast_type: type[T]) -> T:
-    """Cast a value to the provided type using George's convention for values.
 
-    Note:
-        "1" and "on"/"ON" values are considered True when parsing a boolean
-
-    Args:
-        value: the input value
-        cast_type: the type to cast to
+def _enum_caster(cast_type: type[Enum]) -> Caster:
+    """Build a caster that finds the enum member by value (case insensitive) or by index."""
+    members = list(cast_type)
+    by_value = {m.value: m for m in members if isinstance(m.value, str)}
+    by_lower_value: dict[str, Enum] = {}
+    for member in members:
+        if isinstance(member.value, str):
+            by_lower_value.setdefault(member.value.lower(), member)
 
-    Raises:
-        ValueError: if given an enum, and it can't find the value or the enum index is invalid
-
-    Returns:
-        the value cast to the provided type
-    """
-    if issubclass(cast_type, Enum):
+    def cast_enum(value: str) -> Enum:
         value = value.strip().strip('"')
 
-        # Find all enum members that matches the value (lower case)
-        matches = [m for m in cast_type if value.lower() == m.value.lower()]
-        try:
-            # If the unmodified value is in the enum, return that first
-            return cast(T, next(m for m in matches if value == m.value))
-        except StopIteration:
-            # Otherwise return the first match
-            if matches:
-                return cast(T, matches[0])
+        # If the unmodified value is in the enum, return that first
+        # Otherwise return the first match (lower case)
+        member = by_value.get(value)
+        if member is None:
+            member = by_lower_value.get(value.lower())
+        if member is not None:
+            return member
 
         # It didn't work, it can be the enum index
         try:
@@ -103,36 +125,92 @@ def tv_cast_to_type(value: str, cast_type: type[T]) -> T:
             )
 
         # We get the enum member at that index
-        enum_members = list(cast_type)
-        if index < len(enum_members):
-            return cast(T, enum_members[index])
+        if index < len(members):
+            return members[index]
 
         raise ValueError(
-            f"Enum index {index} is out of bounds (max {len(enum_members) - 1})"
+            f"Enum index {index} is out of bounds (max {len(members) - 1})"
         )
 
+    return cast_enum
+
+
+def _tuple_caster(cast_type: Any) -> Caster:
+    """Build a caster that splits the value by space and casts each member to its type."""
+    casters = [compile_caster(t) for t in get_args(cast_type)]
+
+    def cast_tuple(value: str) -> tuple[Any, ...]:
+        return tuple(c(v) for v, c in zip(value.split(" "), casters))
+
+    return cast_tuple
+
+
+def _cast_bool(value: str) -> bool:
+    return value.lower() in ("1", "on", "true")
+
+
+def _cast_str(value: str) -> str:
+    return value.strip().strip('"')
+
+
+@functools.lru_cache(maxsize=None)
+def compile_caster(cast_type: Any) -> Caster:
+    """Get the function that casts a George value to the provided type, it's built once per type.
+
+    Args:
+        cast_type: the type to cast to
+
+    Returns:
+        the caster function
+    """
     if get_origin(cast_type) is tuple:
-        # Split by space and convert each member to the right type
-        values_types = zip(value.split(" "), get_args(cast_type))
-        return cast(T, tuple(tv_cast_to_type(v, t) for v, t in values_types))
+        return _tuple_caster(cast_type)
+
+    if isinstance(cast_type, type) and issubclass(cast_type, Enum):
+        return _enum_caster(cast_type)
 
     if cast_type == bool:
-        return cast(T, value.lower() in ["1", "on", "true"])
+        return _cast_bool
 
     if cast_type == str:
-        return cast(T, value.strip().strip('"'))
+        return _cast_str
+
+    return cast(Caster, cast_type)
+
+
+def tv_cast_to_type(value: str, cast_type: type[T]) -> T:
+    """Cast a value to the provided type using George's convention for values.
 
-    return cast(T, cast_type(value))
+    Note:
+        "1" and "on"/"ON" values are considered True when parsing a boolean
+
+    Args:
+        value: the input value
+        cast_type: the type to cast to
+
+    Raises:
+        ValueError: if given an enum, and it can't find the value or the enum index is invalid
+
+    Returns:
+        the value cast to the provided type
+    """
+    if isinstance(value, DeferredResult):
+        value.unavailable()
+    return cast(T, compile_caster(cast_type)(value))
 
 
 FieldTypes: TypeAlias = list[tuple[str, Any]]
 
+# The field name, the lower case pascal key used by George and the caster of each field
+CompiledFields: TypeAlias = tuple[tuple[str, str, Caster], ...]
+
 
-def _get_dataclass_fields(
-    datacls: DataclassInstance | type[DataclassInstance],
-) -> FieldTypes:
+@functools.lru_cache(maxsize=None)
+def _get_dataclass_fields(datacls: type[DataclassInstance]) -> FieldTypes:
     """Get the dataclass key/type pairs and filter those with the "parsed" metadata.
 
+    The result is cached for each dataclass.
+
     Args:
         datacls: input dataclass
 
@@ -147,6 +225,53 @@ def _get_dataclass_fields(
     ]
 
 
+@functools.lru_cache(maxsize=None)
+def _compile_fields(field_types: tuple[tuple[str, Any], ...]) -> CompiledFields:
+    return tuple(
+        (name, camel_to_pascal(name).lower(), compile_caster(field_type))
+        for name, field_type in field_types
+    )
+
+
+def compile_fields(with_fields: FieldTypes | type[DataclassInstance]) -> CompiledFields:
+    """Get the compiled parser fields of a dataclass or a list of key/types pairs, they are built once.
+
+    Args:
+        with_fields: the field types (can be a dataclass)
+
+    Returns:
+        the field names, George keys and casters
+    """
+    if is_dataclass(with_fields):
+        datacls = with_fields if isinstance(with_fields, type) else type(with_fields)
+        with_fields = _get_dataclass_fields(cast(type[DataclassInstance], datacls))
+    return _compile_fields(tuple(cast(FieldTypes, with_fields)))
+
+
+def _tokenize(text: str) -> list[tuple[int, int]]:
+    """Get the start and end positions of the space separated tokens, quoted strings are one token."""
+    spans: list[tuple[int, int]] = []
+    start = -1
+    string_open = False
+
+    for current, char in enumerate(text):
+        if char == '"':
+            string_open = not string_open
+            if start < 0:
+                start = current
+        elif char == " " and not string_open:
+            if start >= 0:
+                spans.append((start, current))
+                start = -1
+        elif start < 0:
+            start = current
+
+    if start >= 0:
+        spans.append((start, len(text)))
+
+    return spans
+
+
 def tv_parse_dict(
     input_text: str,
     with_fields: FieldTypes | type[DataclassInstance],
@@ -162,45 +287,41 @@ def tv_parse_dict(
     Returns:
         a dict with the values cast to the given types
     """
-    # For dataclasses get the type hints and filter those with metadata
-    if is_dataclass(with_fields):
-        with_fields = _get_dataclass_fields(with_fields)
-    else:
-        # Explicitly cast because we are sure now
-        with_fields = cast(FieldTypes, with_fields)
+    if isinstance(input_text, DeferredResult):
+        input_text.unavailable()
+
+    compiled_fields = compile_fields(with_fields)
+
+    # Tokenize once, the keys are matched with the tokens (case insensitive)
+    spans = _tokenize(input_text)
+    positions: dict[str, list[int]] = {}
+    for index, (start, end) in enumerate(spans):
+        positions.setdefault(input_text[start:end].lower(), []).append(index)
 
     output_dict: dict[str, Any] = {}
     search_start = 0
 
-    for i, (field_name, field_type) in enumerate(with_fields):
-        current_key_pascal = camel_to_pascal(field_name)
-
-        # Search for the key from the end
-        search_text = input_text.lower()
-        try:
-            start = search_text.index(current_key_pascal.lower(), search_start)
-        except ValueError:
+    for i, (field_name, key, caster) in enumerate(compiled_fields):
+        key_index = next((p for p in positions.get(key, []) if p >= search_start), -1)
+        if key_index < 0:
             continue
 
-        if i < (len(with_fields) - 1):
-            # Search for the next key also from the end
-            next_key_pascal = camel_to_pascal(with_fields[i + 1][0])
-            end = search_text.rfind(" " + next_key_pascal.lower(), search_start)
-        else:
-            end = len(input_text)
-
-        # Get the "key value" substring
-        key_value = input_text[start:end]
+        # The value ends at the last occurrence of the next key found after this one
+        value_end = len(spans)
+        for _, next_key, _ in compiled_fields[i + 1 :]:
+            next_positions = [p for p in positions.get(next_key, []) if p > key_index]
+            if next_positions:
+                value_end = next_positions[-1]
+                break
 
-        # Extract the value
-        cut_at = len(current_key_pascal) + 1
-        value = key_value[cut_at:].strip()
+        # Extract the value, including the spaces between its tokens
+        value = ""
+        if key_index + 1 < value_end:
+            value_start = spans[key_index + 1][0]
+            value = input_text[value_start : spans[value_end - 1][1]].strip()
 
-        # Cast it to the corresponding type
-        value = tv_cast_to_type(value, field_type)
-
-        output_dict[field_name] = value
-        search_start = end
+        output_dict[field_name] = caster(value)
+        search_start = value_end
 
     return output_dict
 
@@ -225,6 +346,9 @@ def tv_parse_list(
     Returns:
         a dict with the values cast to the given types
     """
+    if isinstance(output, DeferredResult):
+        output.unavailable()
+
     start = 0
     current = 0
     string_open = False
@@ -251,24 +375,16 @@ def tv_parse_list(
         else:
             current += 1
 
-    # Get type annotations from the dataclass fields
-    if is_dataclass(with_fields):
-        with_fields = _get_dataclass_fields(with_fields)
-    else:
-        # Explicitly cast because we are sure now
-        with_fields = cast(FieldTypes, with_fields)
-
     # Remove any unused values
     if unused_indices:
-        tokens = [t for i, t in enumerate(tokens) if i not in unused_indices]
+        unused = set(unused_indices)
+        tokens = [t for i, t in enumerate(tokens) if i not in unused]
 
     # Cast each token to a type and construct the dict
-    tokens_dict: dict[str, Any] = {}
-    for token, (field_name, field_type) in zip(tokens, with_fields):
-        token = tv_cast_to_type(token, field_type)
-        tokens_dict[field_name] = token
-
-    return tokens_dict
+    return {
+        field_name: caster(token)
+        for token, (field_name, _, caster) in zip(tokens, compile_fields(with_fields))
+    }
 
 
 def args_dict_to_list(args: dict[str, Any]) -> list[Any]:
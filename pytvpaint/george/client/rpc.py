@@ -3,19 +3,49 @@
 from __future__ import annotations
 
 import contextlib
+import functools
 import json
+import os
+import random
 import sys
 import threading
+from collections.abc import Iterator
+from concurrent import futures
+from concurrent.futures import Future, InvalidStateError
 from time import time
-from typing import Any, Union, cast
+from typing import Any, Callable, TypeVar, Union, cast
 
 from typing_extensions import NotRequired, TypedDict
-from websocket import WebSocket, WebSocketException
+from websocket import WebSocket, WebSocketException, WebSocketTimeoutException
 
 from pytvpaint import log
 
 JSONValueType = Union[str, int, float, bool, None]
 
+T = TypeVar("T")
+
+
+def _json_codec() -> tuple[str, Callable[[Any], str], Callable[[str], Any]]:
+    """Get the fastest JSON library installed (orjson, ujson or the standard json module) and its functions.
+
+    The standard library is used if `PYTVPAINT_WS_JSON` is set to `json`.
+    """
+    if os.getenv("PYTVPAINT_WS_JSON", "") != "json":
+        with contextlib.suppress(ImportError):
+            import orjson
+
+            return "orjson", lambda value: orjson.dumps(value).decode(), orjson.loads
+
+        with contextlib.suppress(ImportError):
+            import ujson
+
+            return "ujson", ujson.dumps, ujson.loads
+
+    return "json", json.dumps, json.loads
+
+
+json_library, json_dumps, json_loads = _json_codec()
+
 
 class JSONRPCPayload(TypedDict):
     """A rpc call is represented by sending a Request object to a Server.
@@ -59,50 +89,236 @@ class JSONRPCResponseError(Exception):
         super().__init__(f"JSON-RPC Server error ({error['code']}): {error['message']}")
 
 
+def backoff_delays(initial: float = 0.1, maximum: float = 5) -> Iterator[float]:
+    """Exponential backoff delays with jitter, to retry a connection quickly at first without hammering the server.
+
+    Each delay doubles until the maximum and is randomized between its half and its full value, so that
+    many processes don't retry in lockstep.
+
+    Args:
+        initial: the first delay in seconds. Defaults to 0.1.
+        maximum: the maximum delay in seconds. Defaults to 5.
+
+    Yields:
+        the delays in seconds
+    """
+    delay = initial
+    while True:
+        yield random.uniform(delay / 2, delay)
+        delay = min(delay * 2, maximum)
+
+
 class JSONRPCClient:
     """Simple JSON-RPC 2.0 client over websockets with automatic reconnection.
 
+    Requests are pipelined: they are written to the socket without waiting for the previous
+    response and a reader thread matches each response back to its request by id.
+
+    The client can be shared between threads: the writes (requests, pings and reconnections)
+    are serialized by a lock and the requests still in flight when the connection is lost fail
+    with a `ConnectionError` instead of waiting for a response that will never come.
+
+    A heartbeat thread pings the server and reconnects with an exponential backoff when the
+    connection is lost. Without heartbeat, the next request reconnects instead.
+
     See: https://www.jsonrpc.org/specification#notification
     """
 
-    def __init__(self, url: str, timeout: int = 60, version: str = "2.0") -> None:
+    def __init__(
+        self,
+        url: str,
+        timeout: int = 60,
+        version: str = "2.0",
+        heartbeat: float = 1,
+    ) -> None:
         """Initialize a new JSON-RPC client with a WebSocket url endpoint.
 
         Args:
             url: the WebSocket url endpoint
-            timeout: the reconnection timeout
+            timeout: the time in seconds after which we stop reconnecting or waiting for a response, 0 to wait forever
             version: The JSON-RPC version. Defaults to "2.0".
+            heartbeat: the interval in seconds between two pings, 0 disables the heartbeat thread. Defaults to 1.
         """
         self.ws_handle = WebSocket()
         self.url = url
         self.rpc_id = 0
         self.timeout = timeout
         self.jsonrpc_version = version
+        self.heartbeat = heartbeat
 
+        # Set while the socket is connected, to wait for the connection without polling
+        self.ready = threading.Event()
         self.stop_ping = threading.Event()
         self.run_forever = False
         self.ping_thread: threading.Thread | None = None
-        self._ping_start_time: float = 0
-
-    def _auto_reconnect(self) -> None:
-        """Automatic WebSocket reconnection in a thread by pinging the server."""
-        while self.run_forever and not self.stop_ping.wait(1):
+        # Incremented on each connection, to tell the errors of a previous socket apart
+        self._connection = 0
+
+        self.reader_thread: threading.Thread | None = None
+        self._pending: dict[int, Future[JSONRPCResponse]] = {}
+        self._pending_lock = threading.Lock()
+        # Only one thread writes to the socket or reconnects it at a time
+        self._socket_lock = threading.RLock()
+
+    def _auto_reconnect(self, stop: threading.Event) -> None:
+        """Ping the server in a thread and reconnect with an exponential backoff when the connection is lost."""
+        while not stop.wait(self.heartbeat):
             try:
-                self.ws_handle.ping()
+                with self._socket_lock:
+                    self.ws_handle.ping()
                 continue
-            except (WebSocketException, ConnectionError):
-                self.ws_handle.close()
-
-            with contextlib.suppress(ConnectionRefusedError):
-                self.connect()
-                log.info(f"Reconnected automatically to endpoint: {self.url}")
+            except (WebSocketException, ConnectionError, OSError):
+                self._close_socket(f"Connection to {self.url} lost")
+
+            lost_time = time()
+            for delay in backoff_delays():
+                with contextlib.suppress(WebSocketException, OSError):
+                    self.connect()
+                    log.info(f"Reconnected automatically to endpoint: {self.url}")
+                    break
+
+                # There's a timeout after which we stop reconnecting
+                if self.timeout and (time() - lost_time) > self.timeout:
+                    log.error(f"Could not reconnect to {self.url} before timeout !")
+                    self.ping_thread = None
+                    return
+                if stop.wait(delay):
+                    return
+
+    def _read_responses(self) -> None:
+        """Receive the responses in a thread and resolve the matching pending requests."""
+        try:
+            while self.run_forever and self.reader_thread is threading.current_thread():
+                # Wake up as soon as the socket is reconnected
+                if not self.ready.wait(0.5):
+                    continue
+
+                connection = self._connection
+                try:
+                    message = self.ws_handle.recv()
+                except WebSocketTimeoutException:
+                    # No traffic for a while (a long command), the socket is still up
+                    continue
+                except (WebSocketException, OSError) as e:
+                    reason = f"Connection to {self.url} lost: {e}"
+                    self._close_socket(reason, connection)
+                    continue
+
+                if message:
+                    self._handle_message(message)
+        except BaseException as e:
+            # Nothing would resolve the requests anymore
+            self._fail_pending(
+                ConnectionError(f"Stopped reading the responses of {self.url}: {e!r}")
+            )
+            raise
+
+    def _handle_message(self, message: str | bytes) -> None:
+        """Decode a message and dispatch its responses, an invalid message is logged and skipped."""
+        try:
+            data = json_loads(message)
+        except (ValueError, UnicodeDecodeError) as e:
+            log.warning(f"Received an invalid JSON-RPC message from {self.url}: {e}")
+            return
+
+        # Batch requests are answered with an array of responses
+        for response in data if isinstance(data, list) else [data]:
+            if not isinstance(response, dict):
+                log.warning(f"Received an invalid JSON-RPC response: {response!r}")
                 continue
+            self._dispatch_response(cast(JSONRPCResponse, response))
+
+    def _dispatch_response(self, response: JSONRPCResponse) -> None:
+        """Resolve the pending request matching the response id."""
+        response_id = response.get("id")
+        if response_id is None and "error" in response:
+            # The server couldn't read the request id (parse error or invalid request)
+            self._fail_pending(JSONRPCResponseError(response["error"]))
+            return
+
+        with self._pending_lock:
+            future = self._pending.pop(cast(int, response_id), None)
+
+        if not future:
+            log.warning(f"Received a response for an unknown request: {response}")
+            return
+
+        # The caller may have cancelled the future in the meantime
+        with contextlib.suppress(InvalidStateError):
+            if "error" in response:
+                future.set_exception(JSONRPCResponseError(response["error"]))
+            else:
+                future.set_result(response)
+
+    def _register(self, request_id: int, future: Future[JSONRPCResponse]) -> None:
+        """Track a request until its response, it is forgotten if the future is cancelled.
+
+        Note:
+            Must be called with `_pending_lock` held.
+        """
+        self._pending[request_id] = future
+        future.add_done_callback(functools.partial(self._forget, request_id))
+
+    def _forget(self, request_id: int, future: Future[JSONRPCResponse]) -> None:
+        """Stop waiting for the response of a cancelled request, a late response is ignored."""
+        if not future.cancelled():
+            return
+        with self._pending_lock:
+            if self._pending.get(request_id) is future:
+                del self._pending[request_id]
+
+    def _fail_pending(self, exc: Exception) -> None:
+        """Fail all the requests that are still waiting for a response."""
+        with self._pending_lock:
+            pending = list(self._pending.values())
+            self._pending.clear()
+
+        for future in pending:
+            with contextlib.suppress(InvalidStateError):
+                future.set_exception(exc)
+
+    def _close_socket(self, reason: str, connection: int | None = None) -> None:
+        """Close the socket and fail the requests sent on it, their responses are lost.
 
-            # There's a timeout after which we stop reconnecting
-            if self.timeout and (time() - self._ping_start_time) > self.timeout:
-                raise ConnectionRefusedError(
-                    "Could not establish connection with a tvpaint instance before timeout !"
-                )
+        Args:
+            reason: the error message of the failed requests
+            connection: only close the socket of that connection, it may have been reconnected by
+                another thread in the meantime. Defaults to None.
+        """
+        with self._socket_lock:
+            if connection is not None and connection != self._connection:
+                return
+            self.ready.clear()
+            self.ws_handle.close()
+        self._fail_pending(ConnectionError(reason))
+
+    def _ensure_connected(self) -> None:
+        """Check the connection before sending a request, without heartbeat it reconnects a lost connection first.
+
+        Raises:
+            ConnectionError: if the client is not connected
+        """
+        # The reader thread is only set between `connect` and `disconnect`
+        if not self.is_connected and not self.heartbeat and self.reader_thread:
+            with contextlib.suppress(WebSocketException, OSError):
+                self.connect(timeout=self.timeout or None)
+
+        if not self.is_connected:
+            raise ConnectionError(
+                f"Can't send rpc message because the client is not connected to {self.url}"
+            )
+
+    def _send(self, message: str) -> None:
+        """Write a message to the socket, the writes of concurrent threads don't interleave.
+
+        A failed write closes the socket, so that the next request or ping reconnects it.
+        """
+        try:
+            with self._socket_lock:
+                self.ws_handle.send(message)
+        except (WebSocketException, OSError):
+            self._close_socket(f"Connection to {self.url} lost")
+            raise
 
     def __del__(self) -> None:
         """Called when the client goes out of scope."""
@@ -114,35 +330,145 @@ class JSONRPCClient:
         return self.ws_handle.connected
 
     def connect(self, timeout: float | None = None) -> None:
-        """Connects to the WebSocket endpoint."""
-        self.ws_handle.connect(self.url, timeout=timeout)
-
-        if not self.ping_thread:
-            self._ping_start_time = time()
+        """Connects to the WebSocket endpoint, the requests sent on a previous connection fail."""
+        with self._socket_lock:
+            was_connected = self.is_connected
+            self.ws_handle.connect(self.url, timeout=timeout)
+            # The timeout is only for the handshake, responses to long commands can take a while
+            self.ws_handle.settimeout(None)
+            self._connection += 1
+            self.ready.set()
+
+        if was_connected:
+            self._fail_pending(ConnectionError(f"Reconnected to {self.url}"))
+
+        self.run_forever = True
+        if self.heartbeat and not self.ping_thread:
+            # Each thread has its own stop event, a stopped thread can't be revived by a new connection
+            self.stop_ping = threading.Event()
             self.ping_thread = threading.Thread(
-                target=self._auto_reconnect, daemon=True
+                target=self._auto_reconnect, args=(self.stop_ping,), daemon=True
             )
-            self.run_forever = True
             self.ping_thread.start()
 
+        if not self.reader_thread:
+            self.reader_thread = threading.Thread(
+                target=self._read_responses, daemon=True
+            )
+            self.reader_thread.start()
+
     def disconnect(self) -> None:
-        """Disconnects from the server."""
+        """Disconnects from the server right away, the threads stop on their own without being waited for."""
         self.run_forever = False
-        if self.ping_thread:
-            self.ping_thread.join()
-
-        self.ws_handle.close()
+        self.stop_ping.set()
+        self.ping_thread = None
+        self.reader_thread = None
+        self._close_socket(f"Disconnected from {self.url}")
 
     def increment_rpc_id(self) -> None:
         """Increments the internal RPC id until it reaches `sys.maxsize`."""
         self.rpc_id = (self.rpc_id + 1) % sys.maxsize
 
+    def submit_remote(
+        self,
+        method: str,
+        params: list[JSONValueType] | None = None,
+    ) -> Future[JSONRPCResponse]:
+        """Sends a remote procedure call without waiting for the response.
+
+        Args:
+            method: the name of the method to be invoked
+            params: the parameter values to be used during the invocation of the method. Defaults to None.
+
+        Raises:
+            ConnectionError: if the client is not connected
+
+        Returns:
+            Future: resolved with the JSON-RPC response payload or a `JSONRPCResponseError`
+        """
+        self._ensure_connected()
+
+        future: Future[JSONRPCResponse] = Future()
+
+        with self._pending_lock:
+            payload: JSONRPCPayload = {
+                "jsonrpc": self.jsonrpc_version,
+                "id": self.rpc_id,
+                "method": method,
+                "params": params or [],
+            }
+            # Register the request before sending it so the reader can't miss the response
+            self._register(payload["id"], future)
+            self.increment_rpc_id()
+
+        try:
+            self._send(json_dumps(payload))
+        except (WebSocketException, ConnectionError, OSError):
+            with self._pending_lock:
+                self._pending.pop(payload["id"], None)
+            raise
+
+        return future
+
+    def submit_remote_batch(
+        self,
+        calls: list[tuple[str, list[JSONValueType] | None]],
+    ) -> list[Future[JSONRPCResponse]]:
+        """Sends multiple remote procedure calls at once in a single batch request.
+
+        All the requests are serialized as a JSON array and sent in one WebSocket frame.
+
+        See: https://www.jsonrpc.org/specification#batch
+
+        Args:
+            calls: the (method, params) of each request
+
+        Raises:
+            ConnectionError: if the client is not connected
+
+        Returns:
+            list[Future]: one future per request, in the same order as the calls
+        """
+        self._ensure_connected()
+
+        # An empty array is not a valid batch request
+        if not calls:
+            return []
+
+        payloads: list[JSONRPCPayload] = []
+        futures: list[Future[JSONRPCResponse]] = []
+
+        with self._pending_lock:
+            for method, params in calls:
+                payload: JSONRPCPayload = {
+                    "jsonrpc": self.jsonrpc_version,
+                    "id": self.rpc_id,
+                    "method": method,
+                    "params": params or [],
+                }
+                future: Future[JSONRPCResponse] = Future()
+                self._register(payload["id"], future)
+                self.increment_rpc_id()
+
+                payloads.append(payload)
+                futures.append(future)
+
+        try:
+            self._send(json_dumps(payloads))
+        except (WebSocketException, ConnectionError, OSError):
+            with self._pending_lock:
+                for payload in payloads:
+                    self._pending.pop(payload["id"], None)
+            raise
+
+        return futures
+
     def execute_remote(
         self,
         method: str,
         params: list[JSONValueType] | None = None,
     ) -> JSONRPCResponse:
-        """Executes a remote procedure call.
+        """Executes a remote procedure call and waits for the response.
 
         Args:
             method: the name of the method to be invoked
@@ -155,25 +481,23 @@ class JSONRPCClient:
         Returns:
             JSONRPCResponse: the JSON-RPC response payload
         """
-        if not self.is_connected:
-            raise ConnectionError(
-                f"Can't send rpc message because the client is not connected to {self.url}"
-            )
+        return self.wait(self.submit_remote(method, params))
 
-        payload: JSONRPCPayload = {
-            "jsonrpc": self.jsonrpc_version,
-            "id": self.rpc_id,
-            "method": method,
-            "params": params or [],
-        }
+    def wait(self, future: Future[T]) -> T:
+        """Wait for the result of a request sent by this client, for at most the client timeout.
 
-        self.ws_handle.send(json.dumps(payload))
-        self.increment_rpc_id()
+        On timeout the future is cancelled, which removes its request from the pending ones.
 
-        result = self.ws_handle.recv()
-        response = cast(JSONRPCResponse, json.loads(result))
-
-        if "error" in response:
-            raise JSONRPCResponseError(response["error"])
+        Raises:
+            TimeoutError: if there's no response before the timeout
 
-        return response
+        Returns:
+            the result of the future
+        """
+        try:
+            return future.result(timeout=self.timeout or None)
+        except futures.TimeoutError:
+            future.cancel()
+            raise TimeoutError(
+                f"No response from {self.url} after {self.timeout} seconds"
+            ) from None
@@ -12,7 +12,8 @@ from typing import Any, Callable, TypeVar, cast, overload
 from typing_extensions import Literal, TypeAlias
 
 from pytvpaint import log
-from pytvpaint.george.client import send_cmd
+from pytvpaint.george.client import GeorgeBatch, batch, send_cmd
+from pytvpaint.george.client.cache import mutates
 from pytvpaint.george.client.parse import (
     FieldTypes,
     args_dict_to_list,
@@ -20,6 +21,7 @@ from pytvpaint.george.client.parse import (
     tv_parse_dict,
     tv_parse_list,
 )
+from pytvpaint.george.exceptions import GeorgeError
 
 
 class GrgErrorValue:
@@ -598,12 +600,14 @@ T = TypeVar("T", bound=Callable[..., Any])
 
 
 def undoable(func: T) -> T:
-    """Decorator to register actions in the TVPaint undo stack."""
+    """Decorator to register actions in the TVPaint undo stack, it's closed even if the function raises."""
 
     def wrapper(*args: Any, **kwargs: Any) -> T:
         tv_undo_open_stack()
-        res = func(*args, **kwargs)
-        tv_undo_close_stack(func.__name__)
+        try:
+            res = func(*args, **kwargs)
+        finally:
+            tv_undo_close_stack(func.__name__)
         return cast(T, res)
 
     return cast(T, wrapper)
@@ -613,8 +617,53 @@ def undoable(func: T) -> T:
 def undoable_stack() -> Generator[None, None, None]:
     """Context manager that creates an undo stack. Useful to undo a sequence of George actions."""
     tv_undo_open_stack()
-    yield
-    tv_undo_close_stack()
+    try:
+        yield
+    finally:
+        tv_undo_close_stack()
+
+
+@contextlib.contextmanager
+def transaction(name: str = "") -> Generator[GeorgeBatch, None, None]:
+    """Context manager that sends George commands in a single batch request wrapped in an undo stack.
+
+    Like in a `batch` context, the commands are deferred and return an empty string, so only use it
+    with functions that don't read the result (setters). If a command returns an error value, the whole
+    stack is undone with `tv_undo` and the error is raised. If an exception is raised in the context,
+    the commands are not sent.
+
+    Nested transactions and batches are merged with the outer one, the commands are sent when the outermost
+    context exits. A nested transaction still opens its own undo stack, but it's not rolled back on its own:
+    an error undoes the outermost transaction, and nothing is undone if the outermost context is a `batch`.
+
+    Example:
+        ```python
+        with george.transaction("hide layers"):
+            for layer_id in layer_ids:
+                george.tv_layer_display_set(layer_id, False)
+        ```
+
+    Args:
+        name: the name of the undo stack. Defaults to "".
+
+    Raises:
+        GeorgeError: the first error returned by one of the commands, after the rollback
+
+    Yields:
+        the batch collecting the commands
+    """
+    sent = False
+    try:
+        with batch() as commands:
+            tv_undo_open_stack()
+            yield commands
+            tv_undo_close_stack(name)
+            sent = True
+    except GeorgeError:
+        # TVPaint executes all the commands of a batch, the closed stack undoes them at once
+        if sent:
+            tv_undo()
+        raise
 
 
 def tv_warn(msg: str) -> None:
@@ -832,6 +881,7 @@ def tv_req_file(
     return None if res.lower() == "cancel" else Path(res)
 
 
+@mutates
 def tv_undo() -> None:
     """Do an undo."""
     send_cmd("tv_Undo")
@@ -905,6 +955,7 @@ def tv_mark_in_get(
     return _tv_mark(MarkType.MARKIN, reference)
 
 
+@mutates
 def tv_mark_in_set(
     reference: MarkReference,
     frame: int | None,
@@ -921,6 +972,7 @@ def tv_mark_out_get(
     return _tv_mark(MarkType.MARKOUT, reference)
 
 
+@mutates
 def tv_mark_out_set(
     reference: MarkReference, frame: int | None, action: MarkAction
 ) -> tuple[int, MarkAction]:
@@ -2,9 +2,11 @@
 
 from __future__ import annotations
 
+from collections.abc import Sequence
 from dataclasses import dataclass
 
-from pytvpaint.george.client import send_cmd
+from pytvpaint.george.client import GeorgeProgram, run_inline_script, send_cmd
+from pytvpaint.george.client.cache import mutates
 from pytvpaint.george.client.parse import (
     tv_parse_list,
     validate_args_list,
@@ -39,6 +41,7 @@ def tv_camera_info_get() -> TVPCamera:
     return TVPCamera(**tv_parse_list(send_cmd("tv_CameraInfo"), with_fields=TVPCamera))
 
 
+@mutates
 def tv_camera_info_set(
     width: int | None = None,
     height: int | None = None,
@@ -66,6 +69,29 @@ def tv_camera_enum_points(index: int) -> TVPCameraPoint:
     return TVPCameraPoint(**tv_parse_list(res, with_fields=TVPCameraPoint))
 
 
+def tv_camera_enum_points_all() -> list[TVPCameraPoint]:
+    """Get the values of all the points of the camera path in a single George call.
+
+    A George script enumerates the points on TVPaint's side.
+
+    Returns:
+        the camera points, in path order
+    """
+    source = """
+point_pos = 0
+tv_CameraEnumPoints point_pos
+WHILE CMP(result, "none") == 0
+    tv_WriteTextFile "append" pytvpaint_output result
+    point_pos = point_pos + 1
+    tv_CameraEnumPoints point_pos
+END
+"""
+    return [
+        TVPCameraPoint(**tv_parse_list(line, with_fields=TVPCameraPoint))
+        for line in run_inline_script(source)
+    ]
+
+
 def tv_camera_interpolation(position: float) -> TVPCameraPoint:
     """Get the position/angle/scale values at the given position on the camera path (between 0 and 1)."""
     res = tv_parse_list(
@@ -75,6 +101,30 @@ def tv_camera_interpolation(position: float) -> TVPCameraPoint:
     return TVPCameraPoint(**res)
 
 
+def tv_camera_interpolation_list(positions: Sequence[float]) -> list[TVPCameraPoint]:
+    """Get the values at several positions on the camera path (between 0 and 1) in a single George call.
+
+    Args:
+        positions: the positions on the camera path
+
+    Returns:
+        the interpolated values, in the order of the positions
+    """
+    if not positions:
+        return []
+
+    program = GeorgeProgram()
+    for position in positions:
+        program.cmd("tv_CameraInterpolation", position)
+        program.write("result")
+
+    return [
+        TVPCameraPoint(**tv_parse_list(line, with_fields=TVPCameraPoint))
+        for line in program.run()
+    ]
+
+
+@mutates
 def tv_camera_insert_point(
     index: int,
     x: float,
@@ -86,11 +136,13 @@ def tv_camera_insert_point(
     send_cmd("tv_CameraInsertPoint", index, x, y, angle, scale)
 
 
+@mutates
 def tv_camera_remove_point(index: int) -> None:
     """Remove a point at the given index."""
     send_cmd("tv_CameraRemovePoint", index)
 
 
+@mutates
 def tv_camera_set_point(
     index: int,
     x: float,
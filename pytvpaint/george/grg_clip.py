@@ -7,7 +7,13 @@ from enum import Enum
 from pathlib import Path
 from typing import Any
 
-from pytvpaint.george.client import send_cmd, try_cmd
+from pytvpaint.george.client import run_inline_script, send_cmd, try_cmd
+from pytvpaint.george.client.cache import (
+    changes_current,
+    current,
+    mutates,
+    sets_current,
+)
 from pytvpaint.george.client.parse import (
     args_dict_to_list,
     tv_parse_dict,
@@ -41,6 +47,13 @@ class TVPClip:
     mark_out: int
     color_idx: int
 
+    @classmethod
+    def from_result(cls, clip_id: int, result: str) -> TVPClip:
+        """Parse the result of `tv_ClipInfo` for the given clip."""
+        clip = tv_parse_dict(result, with_fields=cls)
+        clip["id"] = clip_id
+        return cls(**clip)
+
 
 class PSDSaveMode(Enum):
     """PSD save modes.
@@ -67,9 +80,7 @@ def tv_clip_info(clip_id: int) -> TVPClip:
         NoObjectWithIdError: if given an invalid clip id
     """
     result = send_cmd("tv_ClipInfo", clip_id, error_values=[GrgErrorValue.EMPTY])
-    clip = tv_parse_dict(result, with_fields=TVPClip)
-    clip["id"] = clip_id
-    return TVPClip(**clip)
+    return TVPClip.from_result(clip_id, result)
 
 
 @try_cmd(
@@ -92,20 +103,23 @@ def tv_clip_enum_id(scene_id: int, clip_position: int) -> int:
 
 
 def tv_clip_current_id() -> int:
-    """Get the id of the current clip."""
-    return int(send_cmd("tv_ClipCurrentId"))
+    """Get the id of the current clip, it's tracked in the snapshot cache."""
+    return current("clip", lambda: int(send_cmd("tv_ClipCurrentId")))
 
 
+@mutates
 def tv_clip_new(name: str) -> None:
     """Create a new clip."""
     send_cmd("tv_ClipNew", name, handle_string=False)
 
 
+@mutates
 def tv_clip_duplicate(clip_id: int) -> None:
     """Duplicate the given clip."""
     send_cmd("tv_ClipDuplicate", clip_id)
 
 
+@mutates
 def tv_clip_close(clip_id: int) -> None:
     """Remove the given clip."""
     send_cmd("tv_ClipClose", clip_id)
@@ -124,6 +138,7 @@ def tv_clip_name_get(clip_id: int) -> str:
     return send_cmd("tv_ClipName", clip_id, error_values=[GrgErrorValue.EMPTY])
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid clip id",
@@ -137,6 +152,7 @@ def tv_clip_name_set(clip_id: int, name: str) -> None:
     send_cmd("tv_ClipName", clip_id, name, error_values=[GrgErrorValue.EMPTY])
 
 
+@mutates
 def tv_clip_move(clip_id: int, scene_id: int, position: int) -> None:
     """Manage clip position."""
     send_cmd("tv_ClipMove", clip_id, scene_id, position)
@@ -156,6 +172,7 @@ def tv_clip_hidden_get(clip_id: int) -> bool:
     return bool(int(res))
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid clip id",
@@ -171,6 +188,8 @@ def tv_clip_hidden_set(clip_id: int, new_state: bool) -> None:
     )
 
 
+@sets_current("clip")
+@changes_current("scene", "layer", "frame")
 def tv_clip_select(clip_id: int) -> None:
     """Activate/Make current the given clip."""
     send_cmd("tv_ClipSelect", clip_id)
@@ -190,6 +209,7 @@ def tv_clip_selection_get(clip_id: int) -> bool:
     return bool(int(res))
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid clip id",
@@ -213,6 +233,7 @@ def tv_last_image() -> int:
     return int(send_cmd("tv_LastImage"))
 
 
+@mutates
 @try_cmd(exception_msg="Invalid format for sequence")
 def tv_load_sequence(
     seq_path: Path | str,
@@ -307,11 +328,13 @@ def tv_bookmarks_enum(position: int) -> int:
     )
 
 
+@mutates
 def tv_bookmark_set(frame: int) -> None:
     """Set a bookmark at the given frame."""
     send_cmd("tv_BookmarkSet", frame)
 
 
+@mutates
 def tv_bookmark_clear(frame: int) -> None:
     """Remove a bookmark at the given frame."""
     send_cmd("tv_BookmarkClear", frame)
@@ -332,6 +355,7 @@ def tv_clip_color_get(clip_id: int) -> int:
     return int(send_cmd("tv_ClipColor", clip_id, error_values=[GrgErrorValue.EMPTY]))
 
 
+@mutates
 def tv_clip_color_set(clip_id: int, color_index: int) -> None:
     """Set the clip color."""
     send_cmd("tv_ClipColor", clip_id, color_index, error_values=[GrgErrorValue.EMPTY])
@@ -345,6 +369,7 @@ def tv_clip_action_get(clip_id: int) -> str:
     return send_cmd("tv_ClipAction", clip_id)
 
 
+@mutates
 def tv_clip_action_set(clip_id: int, text: str) -> None:
     """Set the action text of the clip."""
     # See tv_clip_action_get above
@@ -359,6 +384,7 @@ def tv_clip_dialog_get(clip_id: int) -> str:
     return send_cmd("tv_ClipDialog", clip_id)
 
 
+@mutates
 def tv_clip_dialog_set(clip_id: int, dialog: str) -> None:
     """Set the dialog text of the clip."""
     # See tv_clip_action_get above
@@ -373,6 +399,7 @@ def tv_clip_note_get(clip_id: int) -> str:
     return send_cmd("tv_ClipNote", clip_id)
 
 
+@mutates
 def tv_clip_note_set(clip_id: int, note: str) -> None:
     """Set the note text of the clip."""
     # See tv_clip_action_get above
@@ -604,6 +631,76 @@ def tv_sound_clip_info(clip_id: int, track_index: int) -> TVPSound:
     return TVPSound(**res_parse)
 
 
+def tv_sound_clip_info_all(clip_id: int) -> list[TVPSound]:
+    """Get information about all the soundtracks of a clip in a single George call.
+
+    A George script gets the info of each track on TVPaint's side until there are no more tracks.
+
+    Args:
+        clip_id: the clip id
+
+    Returns:
+        the soundtracks info, in track order
+    """
+    source = f"""
+track_index = 0
+tv_SoundClipInfo {clip_id} track_index
+WHILE CMP(result, "-1") + CMP(result, "-2") + CMP(result, "-3") == 0
+    tv_WriteTextFile "append" pytvpaint_output result
+    track_index = track_index + 1
+    tv_SoundClipInfo {clip_id} track_index
+END
+"""
+    return [
+        TVPSound(**tv_parse_list(line, with_fields=TVPSound))
+        for line in run_inline_script(source)
+    ]
+
+
+def tv_sound_clip_info_project() -> list[tuple[int, list[TVPSound]]]:
+    """Get information about the soundtracks of all the clips of the current project in a single George call.
+
+    A George script iterates over the scenes, their clips and the clip soundtracks on TVPaint's side.
+
+    Returns:
+        the clip ids with the info of their soundtracks, in track order
+    """
+    source = """
+scene_pos = 0
+tv_SceneEnumId scene_pos
+WHILE CMP(result, "none") == 0
+    scene_id = result
+    clip_pos = 0
+    tv_ClipEnumId scene_id clip_pos
+    WHILE CMP(result, "none") == 0
+        clip_id = result
+        tv_WriteTextFile "append" pytvpaint_output CONCAT("clip ", clip_id)
+        track_index = 0
+        tv_SoundClipInfo clip_id track_index
+        WHILE CMP(result, "-1") + CMP(result, "-2") + CMP(result, "-3") == 0
+            tv_WriteTextFile "append" pytvpaint_output CONCAT("sound ", result)
+            track_index = track_index + 1
+            tv_SoundClipInfo clip_id track_index
+        END
+        clip_pos = clip_pos + 1
+        tv_ClipEnumId scene_id clip_pos
+    END
+    scene_pos = scene_pos + 1
+    tv_SceneEnumId scene_pos
+END
+"""
+    clips: list[tuple[int, list[TVPSound]]] = []
+    for line in run_inline_script(source):
+        key, info = line.split(" ", 1)
+        if key == "clip":
+            clips.append((int(info), []))
+            continue
+        clips[-1][1].append(TVPSound(**tv_parse_list(info, with_fields=TVPSound)))
+
+    return clips
+
+
+@mutates
 def tv_sound_clip_new(sound_path: Path | str) -> None:
     """Add a new soundtrack."""
     path = Path(sound_path)
@@ -612,11 +709,13 @@ def tv_sound_clip_new(sound_path: Path | str) -> None:
     send_cmd("tv_SoundClipNew", path.as_posix(), error_values=[-1, -2, -3, -4])
 
 
+@mutates
 def tv_sound_clip_remove(track_index: int) -> None:
     """Remove a soundtrack."""
     send_cmd("tv_SoundClipRemove", track_index, error_values=[-2])
 
 
+@mutates
 def tv_sound_clip_reload(clip_id: int, track_index: int) -> None:
     """Reload a soundtrack from its file.
 
@@ -630,6 +729,7 @@ def tv_sound_clip_reload(clip_id: int, track_index: int) -> None:
     send_cmd("tv_SoundClipReload", clip_id, track_index, error_values=[-1, -2, -3])
 
 
+@mutates
 def tv_sound_clip_adjust(
     track_index: int,
     mute: bool | None = None,
@@ -640,9 +740,14 @@ def tv_sound_clip_adjust(
     fade_out_start: float | None = None,
     fade_out_stop: float | None = None,
     color_index: int | None = None,
+    info: TVPSound | None = None,
 ) -> None:
-    """Change a soundtracks settings."""
-    cur_options = tv_sound_clip_info(tv_clip_current_id(), track_index)
+    """Change a soundtracks settings.
+
+    The settings that are not provided are left unchanged, they are read from `info` or fetched
+    from TVPaint if it's None.
+    """
+    cur_options = info or tv_sound_clip_info(tv_clip_current_id(), track_index)
     args: list[int | float | None] = []
 
     optional_args = [
@@ -657,15 +762,16 @@ def tv_sound_clip_adjust(
     for arg, default_value in optional_args:
         args.append(arg if arg is not None else default_value)
 
-    args.append(color_index)
+    args.append(color_index if color_index is not None else cur_options.color_index)
     send_cmd("tv_SoundClipAdjust", track_index, *args, error_values=[-2, -3])
 
 
 def tv_layer_image_get() -> int:
-    """Get the current frame of the current clip."""
-    return int(send_cmd("tv_LayerGetImage"))
+    """Get the current frame of the current clip, it's tracked in the snapshot cache."""
+    return current("frame", lambda: int(send_cmd("tv_LayerGetImage")))
 
 
+@sets_current("frame")
 def tv_layer_image(frame: int) -> None:
     """Set the current frame of the current clip."""
     send_cmd("tv_LayerImage", frame)
@@ -2,12 +2,25 @@
 
 from __future__ import annotations
 
+from collections.abc import Sequence
 from dataclasses import dataclass, field
 from enum import Enum
 from pathlib import Path
 from typing import Any
 
-from pytvpaint.george.client import send_cmd, try_cmd
+from pytvpaint.george.client import (
+    GeorgeProgram,
+    batch,
+    run_inline_script,
+    send_cmd,
+    try_cmd,
+)
+from pytvpaint.george.client.cache import (
+    changes_current,
+    current,
+    mutates,
+    sets_current,
+)
 from pytvpaint.george.client.parse import (
     args_dict_to_list,
     tv_cast_to_type,
@@ -194,10 +207,17 @@ class TVPLayer:
     editable: bool
     stencil_state: StencilMode
 
+    @classmethod
+    def from_result(cls, layer_id: int, result: str) -> TVPLayer:
+        """Parse the result of `tv_LayerInfo` for the given layer."""
+        layer = tv_parse_list(result, with_fields=cls, unused_indices=[7, 8])
+        layer["id"] = layer_id
+        return cls(**layer)
+
 
 def tv_layer_current_id() -> int:
-    """Get the id of the current layer."""
-    return int(send_cmd("tv_LayerCurrentId"))
+    """Get the id of the current layer, it's tracked in the snapshot cache."""
+    return current("layer", lambda: int(send_cmd("tv_LayerCurrentId")))
 
 
 @try_cmd(exception_msg="No layer at provided position")
@@ -235,11 +255,186 @@ def tv_layer_info(layer_id: int) -> TVPLayer:
         NoObjectWithIdError: if given an invalid layer id
     """
     result = send_cmd("tv_LayerInfo", layer_id, error_values=[GrgErrorValue.EMPTY])
-    layer = tv_parse_list(result, with_fields=TVPLayer, unused_indices=[7, 8])
-    layer["id"] = layer_id
-    return TVPLayer(**layer)
+    return TVPLayer.from_result(layer_id, result)
+
+
+def tv_layer_info_all(clip_id: int) -> list[TVPLayer]:
+    """Get information of all the layers of the given clip in a single George call.
+
+    A George script iterates over the layers on TVPaint's side, it selects the clip and then
+    restores the current one.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid clip id
+    """
+    source = f"""
+tv_ClipCurrentId
+current_clip = result
+tv_ClipInfo {clip_id}
+IF CMP(result, "") == 0
+    tv_ClipSelect {clip_id}
+    tv_WriteTextFile "append" pytvpaint_output "layers"
+    layer_pos = 0
+    tv_LayerGetID layer_pos
+    WHILE CMP(result, "none") == 0
+        layer_id = result
+        tv_LayerInfo layer_id
+        line = CONCAT(CONCAT(layer_id, " "), result)
+        tv_WriteTextFile "append" pytvpaint_output line
+        layer_pos = layer_pos + 1
+        tv_LayerGetID layer_pos
+    END
+    tv_ClipSelect current_clip
+END
+"""
+    lines = run_inline_script(source)
+    if not lines or lines[0] != "layers":
+        raise NoObjectWithIdError(clip_id)
+
+    layers: list[TVPLayer] = []
+    for line in lines[1:]:
+        layer_id, info = line.split(" ", 1)
+        layers.append(TVPLayer.from_result(int(layer_id), info))
+
+    return layers
+
+
+@dataclass(frozen=True)
+class TVPClipLayers:
+    """A clip of a project with the info and color index of its layers.
+
+    Attributes:
+        scene_id: the id of the clip's scene
+        clip_id: the clip id
+        clip_name: the clip name
+        layers: the info of the clip layers, in position order
+        color_indices: the color index of each layer
+    """
+
+    scene_id: int
+    clip_id: int
+    clip_name: str
+    layers: list[TVPLayer] = field(default_factory=list)
+    color_indices: list[int] = field(default_factory=list)
+
 
+def tv_clip_layers_enum() -> list[TVPClipLayers]:
+    """Get the clips of the current project with the info and color of their layers in a single George call.
 
+    A George script iterates over the scenes, their clips and the clip layers on TVPaint's side, it
+    selects each clip and then restores the current one.
+
+    Returns:
+        the clips in scene and position order
+    """
+    source = """
+tv_ClipCurrentId
+current_clip = result
+scene_pos = 0
+tv_SceneEnumId scene_pos
+WHILE CMP(result, "none") == 0
+    scene_id = result
+    clip_pos = 0
+    tv_ClipEnumId scene_id clip_pos
+    WHILE CMP(result, "none") == 0
+        clip_id = result
+        tv_ClipName clip_id
+        line = CONCAT(CONCAT("clip ", scene_id), CONCAT(" ", clip_id))
+        tv_WriteTextFile "append" pytvpaint_output CONCAT(CONCAT(line, " "), result)
+        tv_ClipSelect clip_id
+        layer_pos = 0
+        tv_LayerGetID layer_pos
+        WHILE CMP(result, "none") == 0
+            layer_id = result
+            tv_LayerColor "get" layer_id
+            line = CONCAT(CONCAT(layer_id, " "), CONCAT(result, " "))
+            tv_LayerInfo layer_id
+            tv_WriteTextFile "append" pytvpaint_output CONCAT(line, result)
+            layer_pos = layer_pos + 1
+            tv_LayerGetID layer_pos
+        END
+        clip_pos = clip_pos + 1
+        tv_ClipEnumId scene_id clip_pos
+    END
+    scene_pos = scene_pos + 1
+    tv_SceneEnumId scene_pos
+END
+tv_ClipSelect current_clip
+"""
+    clips: list[TVPClipLayers] = []
+    for line in run_inline_script(source):
+        if line.startswith("clip "):
+            _, scene_id, clip_id, *name = line.split(" ", 3)
+            clips.append(TVPClipLayers(int(scene_id), int(clip_id), "".join(name)))
+            continue
+
+        layer_id, color_index, info = line.split(" ", 2)
+        clips[-1].layers.append(TVPLayer.from_result(int(layer_id), info))
+        clips[-1].color_indices.append(int(color_index))
+
+    return clips
+
+
+def tv_layer_info_project() -> list[tuple[int, list[TVPLayer]]]:
+    """Get information of all the layers of all the clips of the current project in a single George call.
+
+    The layers are the ones of `tv_clip_layers_enum`, so the scenes, clips and layers are walked over once
+    on TVPaint's side.
+
+    Returns:
+        the clip ids with the info of their layers, in position order
+    """
+    return [(clip.clip_id, clip.layers) for clip in tv_clip_layers_enum()]
+
+
+def tv_exposure_enum_starts_project(
+    clip_layers: Sequence[tuple[int, Sequence[TVPLayer]]],
+) -> dict[int, list[int]]:
+    """Get the start frames of the instances of several layers, in several clips, in a single George call.
+
+    Like `tv_exposure_enum_starts`, a George script goes from instance head to instance head of each
+    layer, then it restores the current clip, layer and frame.
+
+    Args:
+        clip_layers: the clip ids with the info of the layers to enumerate, see `tv_layer_info_project`
+
+    Returns:
+        the sorted instances start frames by layer id
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_ClipCurrentId").assign("current_clip", "result")
+    program.cmd("tv_LayerCurrentId").assign("current_layer", "result")
+    program.cmd("tv_LayerGetImage").assign("current_frame", "result")
+
+    for clip_id, layers in clip_layers:
+        program.cmd("tv_ClipSelect", clip_id)
+        for layer in layers:
+            program.cmd("tv_LayerSet", layer.id)
+            program.assign("frame", layer.first_frame).assign("running", 1)
+            with program.block("WHILE running == 1"):
+                program.write(f'CONCAT("{layer.id} ", frame)')
+                program.cmd("tv_LayerImage", GeorgeProgram.var("frame"))
+                program.cmd("tv_ExposureNext").assign("next_frame", "result")
+                program.assign("running", 0)
+                with program.block("IF next_frame > frame"):
+                    with program.block(f"IF next_frame <= {layer.last_frame}"):
+                        program.assign("frame", "next_frame").assign("running", 1)
+
+    program.cmd("tv_ClipSelect", GeorgeProgram.var("current_clip"))
+    program.cmd("tv_LayerSet", GeorgeProgram.var("current_layer"))
+    program.cmd("tv_LayerImage", GeorgeProgram.var("current_frame"))
+
+    starts: dict[int, list[int]] = {
+        layer.id: [] for _, layers in clip_layers for layer in layers
+    }
+    for line in program.run():
+        layer_id, frame = line.split()
+        starts[int(layer_id)].append(int(frame))
+
+    return starts
+
+
+@mutates
 @try_cmd(exception_msg="Couldn't move current layer to position")
 def tv_layer_move(position: int) -> None:
     """Move the current layer to a new position in the layer stack.
@@ -250,6 +445,7 @@ def tv_layer_move(position: int) -> None:
     send_cmd("tv_LayerMove", position)
 
 
+@sets_current("layer")
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -274,6 +470,7 @@ def tv_layer_selection_get(layer_id: int) -> bool:
     return tv_cast_to_type(res, bool)
 
 
+@mutates
 @try_cmd(raise_exc=NoObjectWithIdError, exception_msg="Invalid layer id")
 def tv_layer_selection_set(layer_id: int, new_state: bool) -> None:
     """Set the selection state of a layer.
@@ -327,16 +524,19 @@ def tv_layer_select_info(full: bool = False) -> tuple[int, int]:
     return frame, count
 
 
+@mutates
 def tv_layer_create(name: str) -> int:
     """Create a new image layer with the given name."""
     return int(send_cmd("tv_LayerCreate", name, handle_string=False))
 
 
+@mutates
 def tv_layer_duplicate(name: str) -> int:
     """Duplicate the current layer and make it the current one."""
     return int(send_cmd("tv_LayerDuplicate", name, handle_string=False))
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -350,6 +550,7 @@ def tv_layer_rename(layer_id: int, name: str) -> None:
     send_cmd("tv_LayerRename", layer_id, name)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -368,6 +569,7 @@ def tv_layer_density_get() -> int:
     return int(send_cmd("tv_LayerDensity"))
 
 
+@mutates
 def tv_layer_density_set(new_density: int) -> None:
     """Set the current layer density (opacity ranging from 0 to 100)."""
     send_cmd("tv_LayerDensity", new_density)
@@ -387,6 +589,7 @@ def tv_layer_display_get(layer_id: int) -> bool:
     return tv_cast_to_type(res.lower(), bool)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -419,6 +622,7 @@ def tv_layer_lock_get(layer_id: int) -> bool:
     return tv_cast_to_type(res.lower(), bool)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -437,6 +641,38 @@ def tv_layer_lock_set(layer_id: int, new_state: bool) -> None:
     )
 
 
+@mutates
+def tv_layers_set(
+    layer_ids: Sequence[int],
+    visible: bool | None = None,
+    locked: bool | None = None,
+    selected: bool | None = None,
+    color_index: int | None = None,
+) -> None:
+    """Set the visibility, lock, selection and color of several layers in a single batch request.
+
+    Args:
+        layer_ids: the layer ids
+        visible: show or hide the layers, unchanged if None. Defaults to None.
+        locked: lock or unlock the layers, unchanged if None. Defaults to None.
+        selected: select or deselect the layers, unchanged if None. Defaults to None.
+        color_index: the index of the layer color in the clip's color list, unchanged if None. Defaults to None.
+
+    Raises:
+        GeorgeError: if given an invalid layer id, all the other layers are still changed
+    """
+    with batch():
+        for layer_id in layer_ids:
+            if visible is not None:
+                tv_layer_display_set(layer_id, visible)
+            if locked is not None:
+                tv_layer_lock_set(layer_id, locked)
+            if selected is not None:
+                tv_layer_selection_set(layer_id, selected)
+            if color_index is not None:
+                tv_layer_color_set(layer_id, color_index)
+
+
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -450,6 +686,7 @@ def tv_layer_collapse_get(layer_id: int) -> bool:
     return bool(int(send_cmd("tv_LayerCollapse", layer_id, error_values=[-2])))
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -477,6 +714,7 @@ def tv_layer_blending_mode_get(layer_id: int) -> BlendingMode:
     return tv_cast_to_type(res.lower(), BlendingMode)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -509,6 +747,7 @@ def tv_layer_stencil_get(layer_id: int) -> StencilMode:
     return tv_cast_to_type(mode, StencilMode)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -547,6 +786,7 @@ def tv_layer_show_thumbnails_get(
     return res == "1"
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -582,6 +822,7 @@ def tv_layer_auto_break_instance_get(layer_id: int) -> bool:
     return res == "1"
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -619,6 +860,7 @@ def tv_layer_auto_create_instance_get(
     return res == "1"
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -651,6 +893,7 @@ def tv_layer_pre_behavior_get(layer_id: int) -> LayerBehavior:
     return tv_cast_to_type(res, LayerBehavior)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -678,6 +921,7 @@ def tv_layer_post_behavior_get(layer_id: int) -> LayerBehavior:
     return tv_cast_to_type(res, LayerBehavior)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -705,6 +949,7 @@ def tv_layer_lock_position_get(layer_id: int) -> bool:
     return tv_cast_to_type(res, bool)
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -725,6 +970,7 @@ def tv_preserve_get() -> LayerTransparency:
     return tv_cast_to_type(state, LayerTransparency)
 
 
+@mutates
 def tv_preserve_set(state: LayerTransparency) -> None:
     """Set the preserve transparency state of the current layer."""
     send_cmd("tv_Preserve", "alpha", state.value)
@@ -750,6 +996,45 @@ def tv_layer_mark_get(layer_id: int, frame: int) -> int:
     return int(send_cmd("tv_LayerMarkGet", layer_id, frame))
 
 
+def tv_layer_marks_enum(
+    layer_ranges: Sequence[tuple[int, int, int]]
+) -> list[tuple[int, int, int]]:
+    """Get all the marks of the given layers and frame ranges in a single George call.
+
+    Args:
+        layer_ranges: the layer ids with the first and last frames to scan
+
+    Raises:
+        NoObjectWithIdError: if given an invalid layer id
+
+    Returns:
+        list[tuple[int, int, int]]: the layer id, frame and color index of each mark
+    """
+    source = ""
+    for layer_id, first_frame, last_frame in layer_ranges:
+        source += f"""
+FOR frame = {first_frame} TO {last_frame}
+    tv_LayerMarkGet {layer_id} frame
+    IF CMP(result, "0") == 0
+        line = CONCAT(CONCAT("{layer_id} ", frame), CONCAT(" ", result))
+        tv_WriteTextFile "append" pytvpaint_output line
+    END
+END
+"""
+    if not source:
+        return []
+
+    marks: list[tuple[int, int, int]] = []
+    for line in run_inline_script(source):
+        layer_id, frame, color_index = line.split(" ", 2)
+        if not color_index.isdigit():
+            raise NoObjectWithIdError(int(layer_id))
+        marks.append((int(layer_id), int(frame), int(color_index)))
+
+    return marks
+
+
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -768,6 +1053,7 @@ def tv_layer_mark_set(layer_id: int, frame: int, color_index: int) -> None:
     send_cmd("tv_LayerMarkSet", layer_id, frame, color_index)
 
 
+@mutates
 def tv_layer_anim(layer_id: int) -> None:
     """Convert the layer to an anim layer."""
     send_cmd("tv_LayerAnim", *([layer_id] if layer_id else []))
@@ -778,16 +1064,19 @@ def tv_layer_copy() -> None:
     send_cmd("tv_LayerCopy")
 
 
+@mutates
 def tv_layer_cut() -> None:
     """Cut the current image or the selected ones."""
     send_cmd("tv_LayerCut")
 
 
+@mutates
 def tv_layer_paste() -> None:
     """Paste the previously copied/cut images to the current layer."""
     send_cmd("tv_LayerPaste")
 
 
+@mutates
 def tv_layer_insert_image(
     count: int = 1,
     direction: InsertDirection | None = None,
@@ -806,6 +1095,7 @@ def tv_layer_insert_image(
     send_cmd("tv_LayerInsertImage", *args)
 
 
+@mutates
 def tv_layer_merge(
     layer_id: int,
     blending_mode: BlendingMode,
@@ -846,6 +1136,7 @@ def tv_layer_merge(
     send_cmd("tv_LayerMerge", layer_id, *args)
 
 
+@mutates
 def tv_layer_merge_all(
     keep_color_grp: bool = True,
     keep_img_mark: bool = True,
@@ -866,6 +1157,7 @@ def tv_layer_merge_all(
     send_cmd("tv_LayerMergeAll", *args_dict_to_list(args_dict))
 
 
+@mutates
 def tv_layer_shift(layer_id: int, start: int) -> None:
     """Move the layer to a new frame.
 
@@ -910,6 +1202,38 @@ def tv_layer_color_get_color(clip_id: int, color_index: int) -> TVPClipLayerColo
     return TVPClipLayerColor(**parsed)
 
 
+def tv_layer_colors_get(clip_id: int) -> list[TVPClipLayerColor]:
+    """Get all the colors information of the clips color list in a single George call.
+
+    Raises:
+        NoObjectWithIdError: if given an invalid clip id
+
+    Returns:
+        the 26 colors of the clip, in index order
+    """
+    program = GeorgeProgram()
+    with program.block("FOR color_index = 0 TO 25"):
+        program.cmd(
+            "tv_LayerColor",
+            LayerColorAction.GETCOLOR.value,
+            clip_id,
+            GeorgeProgram.var("color_index"),
+        )
+        program.write("result")
+
+    colors = []
+    for line in program.run():
+        if line.lower() == GrgErrorValue.ERROR:
+            raise NoObjectWithIdError(clip_id)
+        parsed = tv_parse_list(line, with_fields=TVPClipLayerColor)
+        colors.append(TVPClipLayerColor(**parsed))
+
+    if not colors:
+        raise NoObjectWithIdError(clip_id)
+    return colors
+
+
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid layer id",
@@ -962,6 +1286,7 @@ def tv_layer_color_get(layer_id: int) -> int:
     return int(res)
 
 
+@mutates
 @try_cmd(raise_exc=NoObjectWithIdError)
 def tv_layer_color_set(layer_id: int, color_index: int) -> None:
     """Set the layer's color index from the clips color list.
@@ -978,6 +1303,7 @@ def tv_layer_color_set(layer_id: int, color_index: int) -> None:
     )
 
 
+@mutates
 def tv_layer_color_lock(color_index: int) -> int:
     """Lock all layers that use the given color index.
 
@@ -990,6 +1316,7 @@ def tv_layer_color_lock(color_index: int) -> int:
     return int(send_cmd("tv_LayerColor", LayerColorAction.LOCK.value, color_index))
 
 
+@mutates
 def tv_layer_color_unlock(color_index: int) -> int:
     """Unlock all layers that use the given color index.
 
@@ -1002,6 +1329,7 @@ def tv_layer_color_unlock(color_index: int) -> int:
     return int(send_cmd("tv_LayerColor", LayerColorAction.UNLOCK.value, color_index))
 
 
+@mutates
 def tv_layer_color_show(mode: LayerColorDisplayOpt, color_index: int) -> int:
     """Show all layers that use the given color index.
 
@@ -1022,6 +1350,7 @@ def tv_layer_color_show(mode: LayerColorDisplayOpt, color_index: int) -> int:
     return int(res)
 
 
+@mutates
 def tv_layer_color_hide(mode: LayerColorDisplayOpt, color_index: int) -> int:
     """Hide all layers that use the given color index.
 
@@ -1063,6 +1392,7 @@ def tv_layer_color_visible(color_index: int) -> bool:
     )
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid color index",
@@ -1076,6 +1406,7 @@ def tv_layer_color_select(color_index: int) -> int:
     return int(send_cmd("tv_LayerColor", LayerColorAction.SELECT.value, color_index))
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid color index",
@@ -1089,6 +1420,7 @@ def tv_layer_color_unselect(color_index: int) -> int:
     return int(send_cmd("tv_LayerColor", LayerColorAction.UNSELECT.value, color_index))
 
 
+@mutates
 def tv_instance_name(
     layer_id: int,
     mode: InstanceNamingMode,
@@ -1144,6 +1476,41 @@ def tv_instance_get_name(layer_id: int, frame: int) -> str:
     return send_cmd("tv_InstanceGetName", layer_id, frame).strip('"')
 
 
+def tv_instance_names_enum(layer_id: int, frames: Sequence[int]) -> list[str]:
+    """Get the names of several instances of a layer in a single George call.
+
+    Args:
+        layer_id: the layer id
+        frames: the frames of the instances
+
+    Raises:
+        NoObjectWithIdError: if given an invalid layer id or an invalid instance frame
+
+    Returns:
+        the instance names, in the order of the frames
+    """
+    if not frames:
+        return []
+
+    program = GeorgeProgram()
+    for frame in frames:
+        program.cmd("tv_InstanceGetName", layer_id, frame)
+        # Prefix the names so that empty names are still written as a line
+        program.write('CONCAT("name:", result)')
+
+    names = []
+    for line in program.run():
+        name = line[len("name:") :]
+        if not line.startswith("name:") or name.upper().startswith("ERROR"):
+            raise NoObjectWithIdError(layer_id)
+        names.append(name.strip('"'))
+
+    if len(names) != len(frames):
+        raise NoObjectWithIdError(layer_id)
+    return names
+
+
+@mutates
 @try_cmd(exception_msg="Invalid layer id or no instance at given frame")
 def tv_instance_set_name(layer_id: int, frame: int, name: str) -> str:
     """Set the name of an instance.
@@ -1154,6 +1521,7 @@ def tv_instance_set_name(layer_id: int, frame: int, name: str) -> str:
     return send_cmd("tv_InstanceSetName", layer_id, frame, name)
 
 
+@changes_current("frame")
 def tv_exposure_next() -> int:
     """Go to the next layer instance head.
 
@@ -1163,6 +1531,7 @@ def tv_exposure_next() -> int:
     return int(send_cmd("tv_ExposureNext"))
 
 
+@mutates
 def tv_exposure_break(frame: int) -> None:
     """Break a layer instance/exposure at the given frame.
 
@@ -1172,6 +1541,7 @@ def tv_exposure_break(frame: int) -> None:
     send_cmd("tv_ExposureBreak", frame)
 
 
+@mutates
 def tv_exposure_add(frame: int, count: int) -> None:
     """Add new frames to an existing layer instance/exposure.
 
@@ -1182,6 +1552,7 @@ def tv_exposure_add(frame: int, count: int) -> None:
     send_cmd("tv_ExposureAdd", frame, count)
 
 
+@mutates
 def tv_exposure_set(frame: int, count: int) -> None:
     """Set the number frames of an existing layer instance/exposure.
 
@@ -1192,6 +1563,7 @@ def tv_exposure_set(frame: int, count: int) -> None:
     send_cmd("tv_ExposureSet", frame, count)
 
 
+@changes_current("frame")
 def tv_exposure_prev() -> int:
     """Go to the previous layer instance head (*before* the current instance).
 
@@ -1201,6 +1573,220 @@ def tv_exposure_prev() -> int:
     return int(send_cmd("tv_ExposurePrev"))
 
 
+def tv_exposure_enum_starts(first_frame: int, last_frame: int) -> list[int]:
+    """Get the start frames of all the instances of the current layer in a single George call.
+
+    A George script goes from instance head to instance head with `tv_ExposureNext` on
+    TVPaint's side and then restores the current frame.
+
+    Args:
+        first_frame: the first frame of the layer
+        last_frame: the last frame of the layer
+
+    Returns:
+        the sorted instances start frames
+    """
+    source = f"""
+tv_LayerGetImage
+current_frame = result
+frame = {first_frame}
+running = 1
+WHILE running == 1
+    tv_WriteTextFile "append" pytvpaint_output frame
+    tv_LayerImage frame
+    tv_ExposureNext
+    next_frame = result
+    running = 0
+    IF next_frame > frame
+        IF next_frame <= {last_frame}
+            frame = next_frame
+            running = 1
+        END
+    END
+END
+tv_LayerImage current_frame
+"""
+    return [int(line) for line in run_inline_script(source)]
+
+
+@mutates
+def tv_layer_add_instance(
+    layer_id: int,
+    temp_layer_name: str,
+    temp_frame: int,
+    frame: int,
+    count: int = 1,
+    direction: InsertDirection | None = None,
+    split: bool = False,
+) -> None:
+    """Add a new instance to a layer in a single George call.
+
+    A George script creates a temporary animation layer, makes an instance of `count` frames in it
+    (or `count` images if `split` is True), then copies it to the given layer and removes the
+    temporary layer. The current frame is restored and the given layer is made current.
+
+    Args:
+        layer_id: the layer id
+        temp_layer_name: the name of the temporary layer
+        temp_frame: the frame where the temporary instance is created
+        frame: the frame where the instance is pasted
+        count: the number of frames of the instance. Defaults to 1.
+        direction: the direction where the images are inserted when splitting. Defaults to None.
+        split: True to make each frame a new image. Defaults to False.
+
+    Raises:
+        GeorgeError: if the layer couldn't be made current or the images couldn't be copied or pasted
+    """
+    var = GeorgeProgram.var
+    program = GeorgeProgram()
+    program.cmd("tv_LayerGetImage").assign("current_frame", "result")
+    program.cmd("tv_LayerCreate", temp_layer_name, handle_string=False).check()
+    program.assign("temp_id", "result")
+    program.cmd("tv_LayerAnim", var("temp_id"))
+    program.cmd("tv_LayerShowThumbnails", var("temp_id"), 1)
+    program.cmd("tv_LayerImage", temp_frame)
+
+    if count > 1 and split:
+        args_dict = {
+            "count": count,
+            "direction": direction.value if direction is not None else None,
+        }
+        program.cmd("tv_LayerInsertImage", *args_dict_to_list(args_dict))
+    elif count > 1:
+        program.cmd("tv_layerSelectInfo", "full")
+        program.raw("PARSE result temp_start temp_count")
+        program.cmd("tv_ExposureSet", var("temp_start"), count)
+
+    program.cmd("tv_layerSelectInfo", "full")
+    program.raw("PARSE result temp_start temp_count")
+    program.cmd("tv_LayerSelect", var("temp_start"), var("temp_count"))
+    with program.checks():
+        program.cmd("tv_LayerCopy").check()
+        program.cmd("tv_LayerImage", frame)
+        program.cmd("tv_LayerSet", layer_id).check()
+        program.cmd("tv_LayerPaste").check()
+    program.cmd("tv_LayerLock", var("temp_id"), 0)
+    program.cmd("tv_LayerKill", var("temp_id"))
+    program.cmd("tv_LayerImage", var("current_frame"))
+    program.run_checked()
+
+
+@mutates
+def tv_exposure_duplicate(
+    layer_id: int, frame: int, count: int, paste_frame: int, move_frame: int
+) -> None:
+    """Duplicate the images of a layer instance in a single George call.
+
+    A George script moves to `move_frame`, copies the `count` images starting at `frame` and pastes
+    them at `paste_frame`. The current frame is restored and the layer is made current.
+
+    Args:
+        layer_id: the layer id
+        frame: the first frame of the instance
+        count: the number of frames of the instance
+        paste_frame: the frame where the images are pasted
+        move_frame: the current frame while copying, TVPaint won't insert images at the instance start
+
+    Raises:
+        GeorgeError: if the layer couldn't be made current or the images couldn't be copied or pasted
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_LayerGetImage").assign("current_frame", "result")
+    program.cmd("tv_LayerSet", layer_id).check()
+    with program.checks():
+        program.cmd("tv_LayerImage", move_frame)
+        program.cmd("tv_LayerSelect", frame, count)
+        program.cmd("tv_LayerCopy").check()
+        program.cmd("tv_LayerImage", paste_frame)
+        program.cmd("tv_LayerPaste").check()
+    program.cmd("tv_LayerImage", GeorgeProgram.var("current_frame"))
+    program.run_checked()
+
+
+@mutates
+def tv_layer_exposure_break(layer_id: int, frame: int) -> None:
+    """Make the layer current and break its instance at the given frame in a single George call.
+
+    Args:
+        layer_id: the layer id
+        frame: the split frame
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", layer_id)
+    program.cmd("tv_ExposureBreak", frame)
+    program.run()
+
+
+@mutates
+def tv_layer_exposures_set(
+    layer_id: int, exposures: Sequence[tuple[int, int]], undo_name: str = ""
+) -> None:
+    """Set the number of frames of several instances of a layer in a single George call and undo stack.
+
+    The exposures are set from the last frame to the first one, so that the frames of the instances
+    that are not set yet don't move.
+
+    Args:
+        layer_id: the layer id
+        exposures: the start frames of the instances and their new number of frames
+        undo_name: the name of the undo stack. Defaults to "".
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_UndoOpenStack")
+    program.cmd("tv_LayerSet", layer_id)
+    for frame, count in sorted(exposures, reverse=True):
+        program.cmd("tv_ExposureSet", frame, count)
+    program.cmd("tv_UndoCloseStack", undo_name)
+    program.run()
+
+
+@mutates
+def tv_layer_select_copy(
+    layer_id: int, start_frame: int, frame_count: int, cut: bool = False
+) -> None:
+    """Make the layer current, select frames and copy (or cut) them in a single George call.
+
+    Args:
+        layer_id: the layer id
+        start_frame: selection start
+        frame_count: number of frames to select
+        cut: True to cut the images instead of copying them. Defaults to False.
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", layer_id)
+    program.cmd("tv_LayerSelect", start_frame, frame_count)
+    program.cmd("tv_LayerCut" if cut else "tv_LayerCopy")
+    program.run()
+
+
+@mutates
+def tv_layer_paste_at(layer_id: int, frame: int | None = None) -> None:
+    """Make the layer current and paste the copied/cut images at the given frame in a single George call.
+
+    The current frame is restored after pasting.
+
+    Args:
+        layer_id: the layer id
+        frame: the frame where the images are pasted, the current frame if None. Defaults to None.
+
+    Raises:
+        GeorgeError: if the layer couldn't be made current or the images couldn't be copied or pasted
+    """
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", layer_id).check()
+    if frame is None:
+        program.cmd("tv_LayerPaste").check()
+        program.run_checked()
+        return
+
+    program.cmd("tv_LayerGetImage").assign("current_frame", "result")
+    with program.checks():
+        program.cmd("tv_LayerImage", frame)
+        program.cmd("tv_LayerPaste").check()
+    program.cmd("tv_LayerImage", GeorgeProgram.var("current_frame"))
+    program.run_checked()
+
+
 @try_cmd(exception_msg="No file found or invalid format")
 def tv_save_image(export_path: Path | str) -> None:
     """Save the current image of the current layer.
@@ -1212,6 +1798,7 @@ def tv_save_image(export_path: Path | str) -> None:
     send_cmd("tv_SaveImage", export_path.as_posix())
 
 
+@mutates
 @try_cmd(exception_msg="Invalid image format")
 def tv_load_image(img_path: Path | str, stretch: bool = False) -> None:
     """Load an image in the current image layer.
@@ -7,7 +7,13 @@ from enum import Enum
 from pathlib import Path
 from typing import Any
 
-from pytvpaint.george.client import send_cmd, try_cmd
+from pytvpaint.george.client import run_inline_script, send_cmd, try_cmd
+from pytvpaint.george.client.cache import (
+    changes_current,
+    current,
+    mutates,
+    sets_current,
+)
 from pytvpaint.george.client.parse import (
     tv_cast_to_type,
     tv_parse_list,
@@ -36,6 +42,13 @@ class TVPProject:
     field_order: FieldOrder
     start_frame: int
 
+    @classmethod
+    def from_result(cls, project_id: str, result: str) -> TVPProject:
+        """Parse the result of `tv_ProjectInfo` for the given project."""
+        project = tv_parse_list(result, with_fields=cls)
+        project["id"] = project_id
+        return cls(**project)
+
 
 class BackgroundMode(Enum):
     """The project background mode.
@@ -76,6 +89,7 @@ def tv_background_get() -> (
     return BackgroundMode.COLOR, RGBColor(*map(int, values))
 
 
+@mutates
 def tv_background_set(
     mode: BackgroundMode,
     color: tuple[RGBColor, RGBColor] | RGBColor | None = None,
@@ -97,6 +111,7 @@ def tv_background_set(
     send_cmd("tv_Background", mode.value, *args)
 
 
+@mutates
 @try_cmd(exception_msg="Project created but may be corrupted")
 def tv_project_new(
     project_path: Path | str,
@@ -125,6 +140,7 @@ def tv_project_new(
     )
 
 
+@mutates
 @try_cmd(exception_msg="Invalid format")
 def tv_load_project(project_path: Path | str, silent: bool = False) -> str:
     """Load a file as a project if possible or open Import panel.
@@ -146,6 +162,7 @@ def tv_load_project(project_path: Path | str, silent: bool = False) -> str:
     return send_cmd("tv_LoadProject", *args, error_values=[-1])
 
 
+@mutates
 def tv_save_project(project_path: Path | str) -> None:
     """Save the current project as tvpp."""
     project_path = Path(project_path)
@@ -158,6 +175,7 @@ def tv_save_project(project_path: Path | str) -> None:
     send_cmd("tv_SaveProject", project_path.as_posix())
 
 
+@mutates
 @try_cmd(exception_msg="Can't duplicate the current project")
 def tv_project_duplicate() -> None:
     """Duplicate the current project.
@@ -179,8 +197,8 @@ def tv_project_enum_id(position: int) -> str:
 
 
 def tv_project_current_id() -> str:
-    """Get the id of the current project."""
-    return send_cmd("tv_ProjectCurrentId")
+    """Get the id of the current project, it's tracked in the snapshot cache."""
+    return current("project", lambda: send_cmd("tv_ProjectCurrentId"))
 
 
 @try_cmd(
@@ -194,9 +212,7 @@ def tv_project_info(project_id: str) -> TVPProject:
         NoObjectWithIdError: if given an invalid project id
     """
     result = send_cmd("tv_ProjectInfo", project_id, error_values=[GrgErrorValue.EMPTY])
-    project = tv_parse_list(result, with_fields=TVPProject)
-    project["id"] = project_id
-    return TVPProject(**project)
+    return TVPProject.from_result(project_id, result)
 
 
 def tv_get_project_name() -> str:
@@ -204,16 +220,20 @@ def tv_get_project_name() -> str:
     return send_cmd("tv_GetProjectName")
 
 
+@sets_current("project")
+@mutates
 def tv_project_select(project_id: str) -> str:
     """Make the given project current."""
     return send_cmd("tv_ProjectSelect", project_id)
 
 
+@mutates
 def tv_project_close(project_id: str) -> None:
     """Close the given project."""
     send_cmd("tv_ProjectClose", project_id)
 
 
+@mutates
 def tv_resize_project(width: int, height: int) -> None:
     """Resize the current project.
 
@@ -223,6 +243,7 @@ def tv_resize_project(width: int, height: int) -> None:
     send_cmd("tv_ResizeProject", width, height)
 
 
+@mutates
 def tv_resize_page(width: int, height: int, resize_opt: ResizeOption) -> None:
     """Create a new resized project and close the current one."""
     send_cmd("tv_ResizePage", width, height, resize_opt.value)
@@ -274,6 +295,7 @@ def tv_project_save_sequence(
     )
 
 
+@mutates
 def tv_project_render_camera(project_id: str) -> str:
     """Render the given project's camera view to a new project.
 
@@ -300,6 +322,7 @@ def tv_frame_rate_get() -> tuple[float, float]:
     return project_fps, playback_fps
 
 
+@mutates
 def tv_frame_rate_set(
     frame_rate: float, time_stretch: bool = False, preview: bool = False
 ) -> None:
@@ -313,6 +336,7 @@ def tv_frame_rate_set(
     send_cmd("tv_FrameRate", *args)
 
 
+@mutates
 def tv_frame_rate_project_set(frame_rate: float, time_stretch: bool = False) -> None:
     """Set the framerate of the current project."""
     args: list[Any] = [frame_rate]
@@ -321,6 +345,7 @@ def tv_frame_rate_project_set(frame_rate: float, time_stretch: bool = False) ->
     send_cmd("tv_FrameRate", *args)
 
 
+@mutates
 def tv_frame_rate_preview_set(frame_rate: float) -> None:
     """Set the framerate of the preview (playback)."""
     send_cmd("tv_FrameRate", frame_rate, "preview")
@@ -331,6 +356,7 @@ def tv_project_current_frame_get() -> int:
     return int(send_cmd("tv_ProjectCurrentFrame"))
 
 
+@changes_current("clip", "scene", "layer", "frame")
 def tv_project_current_frame_set(frame: int) -> int:
     """Set the current frame of the current project.
 
@@ -388,6 +414,33 @@ def tv_sound_project_info(project_id: str, track_index: int) -> TVPSound:
     return TVPSound(**res_parse)
 
 
+def tv_sound_project_info_all(project_id: str) -> list[TVPSound]:
+    """Get information about all the soundtracks of a project in a single George call.
+
+    A George script gets the info of each track on TVPaint's side until there are no more tracks.
+
+    Args:
+        project_id: the project id
+
+    Returns:
+        the soundtracks info, in track order
+    """
+    source = f"""
+track_index = 0
+tv_SoundProjectInfo {project_id} track_index
+WHILE CMP(result, "-1") + CMP(result, "-2") + CMP(result, "-3") == 0
+    tv_WriteTextFile "append" pytvpaint_output result
+    track_index = track_index + 1
+    tv_SoundProjectInfo {project_id} track_index
+END
+"""
+    return [
+        TVPSound(**tv_parse_list(line, with_fields=TVPSound))
+        for line in run_inline_script(source)
+    ]
+
+
+@mutates
 def tv_sound_project_new(sound_path: Path | str) -> None:
     """Add a new soundtrack to the current project."""
     path = Path(sound_path)
@@ -397,11 +450,13 @@ def tv_sound_project_new(sound_path: Path | str) -> None:
     send_cmd("tv_SoundProjectNew", path.as_posix(), error_values=[-1, -3, -4])
 
 
+@mutates
 def tv_sound_project_remove(track_index: int) -> None:
     """Remove a soundtrack from the current project."""
     send_cmd("tv_SoundProjectRemove", track_index, error_values=[-2])
 
 
+@mutates
 def tv_sound_project_reload(project_id: str, track_index: int) -> None:
     """Reload a project soundtracks file."""
     send_cmd(
@@ -412,6 +467,7 @@ def tv_sound_project_reload(project_id: str, track_index: int) -> None:
     )
 
 
+@mutates
 def tv_sound_project_adjust(
     track_index: int,
     mute: bool | None = None,
@@ -422,9 +478,14 @@ def tv_sound_project_adjust(
     fade_out_start: float | None = None,
     fade_out_stop: float | None = None,
     color_index: int | None = None,
+    info: TVPSound | None = None,
 ) -> None:
-    """Change the current project's soundtrack settings."""
-    cur_options = tv_sound_project_info(tv_project_current_id(), track_index)
+    """Change the current project's soundtrack settings.
+
+    The settings that are not provided are left unchanged, they are read from `info` or fetched
+    from TVPaint if it's None.
+    """
+    cur_options = info or tv_sound_project_info(tv_project_current_id(), track_index)
     args: list[int | float | None] = []
 
     optional_args = [
@@ -439,7 +500,7 @@ def tv_sound_project_adjust(
     for arg, default_value in optional_args:
         args.append(arg if arg is not None else default_value)
 
-    args.append(color_index)
+    args.append(color_index if color_index is not None else cur_options.color_index)
     send_cmd("tv_SoundProjectAdjust", track_index, *args, error_values=[-2, -3])
 
 
@@ -460,6 +521,7 @@ def tv_project_header_info_get(project_id: str) -> str:
     ).strip('"')
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid project id",
@@ -495,6 +557,7 @@ def tv_project_header_author_get(project_id: str) -> str:
     ).strip('"')
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid project id",
@@ -530,6 +593,7 @@ def tv_project_header_notes_get(project_id: str) -> str:
     ).strip('"')
 
 
+@mutates
 @try_cmd(
     raise_exc=NoObjectWithIdError,
     exception_msg="Invalid project id",
@@ -553,6 +617,7 @@ def tv_start_frame_get() -> int:
     return int(send_cmd("tv_StartFrame"))
 
 
+@mutates
 def tv_start_frame_set(start_frame: int) -> int:
     """Set the start frame of the current project."""
     return int(send_cmd("tv_StartFrame", start_frame))
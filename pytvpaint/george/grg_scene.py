@@ -2,7 +2,8 @@
 
 from __future__ import annotations
 
-from pytvpaint.george.client import send_cmd, try_cmd
+from pytvpaint.george.client import run_inline_script, send_cmd, try_cmd
+from pytvpaint.george.client.cache import current, mutates
 from pytvpaint.george.grg_base import GrgErrorValue
 
 
@@ -17,25 +18,96 @@ def tv_scene_enum_id(position: int) -> int:
 
 
 def tv_scene_current_id() -> int:
-    """Get the id of the current scene."""
-    return int(send_cmd("tv_SceneCurrentId"))
+    """Get the id of the current scene, it's tracked in the snapshot cache."""
+    return current("scene", lambda: int(send_cmd("tv_SceneCurrentId")))
 
 
+def tv_scene_clips_enum() -> list[tuple[int, list[int]]]:
+    """Get the ids of the scenes of the current project and of their clips in a single George call.
+
+    A George script enumerates the scenes and their clips on TVPaint's side.
+
+    Returns:
+        the scene ids with their clip ids, in position order
+    """
+    source = """
+scene_pos = 0
+tv_SceneEnumId scene_pos
+WHILE CMP(result, "none") == 0
+    scene_id = result
+    line = scene_id
+    clip_pos = 0
+    tv_ClipEnumId scene_id clip_pos
+    WHILE CMP(result, "none") == 0
+        line = CONCAT(CONCAT(line, " "), result)
+        clip_pos = clip_pos + 1
+        tv_ClipEnumId scene_id clip_pos
+    END
+    tv_WriteTextFile "append" pytvpaint_output line
+    scene_pos = scene_pos + 1
+    tv_SceneEnumId scene_pos
+END
+"""
+    scenes: list[tuple[int, list[int]]] = []
+    for line in run_inline_script(source):
+        scene_id, *clip_ids = map(int, line.split())
+        scenes.append((scene_id, clip_ids))
+    return scenes
+
+
+def tv_clip_names_enum() -> list[tuple[int, int, str]]:
+    """Get the names of the clips of the current project in a single George call.
+
+    A George script enumerates the scenes and their clips on TVPaint's side, without selecting them.
+
+    Returns:
+        the scene id, clip id and name of each clip, in scene and position order
+    """
+    source = """
+scene_pos = 0
+tv_SceneEnumId scene_pos
+WHILE CMP(result, "none") == 0
+    scene_id = result
+    clip_pos = 0
+    tv_ClipEnumId scene_id clip_pos
+    WHILE CMP(result, "none") == 0
+        clip_id = result
+        tv_ClipName clip_id
+        ids = CONCAT(CONCAT(scene_id, " "), CONCAT(clip_id, " "))
+        tv_WriteTextFile "append" pytvpaint_output CONCAT(ids, result)
+        clip_pos = clip_pos + 1
+        tv_ClipEnumId scene_id clip_pos
+    END
+    scene_pos = scene_pos + 1
+    tv_SceneEnumId scene_pos
+END
+"""
+    clips: list[tuple[int, int, str]] = []
+    for line in run_inline_script(source):
+        scene_id, clip_id, *name = line.split(" ", 2)
+        clips.append((int(scene_id), int(clip_id), "".join(name)))
+    return clips
+
+
+@mutates
 def tv_scene_move(scene_id: int, position: int) -> None:
     """Move a scene to another position."""
     send_cmd("tv_SceneMove", scene_id, position)
 
 
+@mutates
 def tv_scene_new() -> None:
     """Create a new scene (with a new clip) after the current scene."""
     send_cmd("tv_SceneNew")
 
 
+@mutates
 def tv_scene_duplicate(scene_id: int) -> None:
     """Duplicate the given scene."""
     send_cmd("tv_SceneDuplicate", scene_id)
 
 
+@mutates
 def tv_scene_close(scene_id: int) -> None:
     """Remove the given scene."""
     send_cmd("tv_SceneClose", scene_id)
@@ -0,0 +1,154 @@
+"""Raw RGBA images read from TVPaint renders, without encoding them to an output format."""
+
+from __future__ import annotations
+
+import contextlib
+import os
+import tempfile
+from collections.abc import Iterator
+from dataclasses import dataclass
+from pathlib import Path
+
+# TGA image types for uncompressed and run-length encoded true-color images
+_TGA_UNCOMPRESSED = 2
+_TGA_RLE = 10
+_TGA_HEADER_SIZE = 18
+_TGA_TOP_LEFT_ORIGIN = 0x20
+
+
+@dataclass(frozen=True)
+class RGBAImage:
+    """An 8 bits per channel RGBA image, the rows go from top to bottom.
+
+    The pixels support the buffer protocol, for example with numpy:
+
+    ```python
+    array = numpy.asarray(image.pixels)  # shape (height, width, 4)
+    ```
+
+    Attributes:
+        width: the image width in pixels
+        height: the image height in pixels
+        data: the RGBA values of each pixel
+    """
+
+    width: int
+    height: int
+    data: bytes
+
+    @property
+    def pixels(self) -> memoryview:
+        """Read-only view of the pixels with a (height, width, 4) shape."""
+        return memoryview(self.data).cast("B", (self.height, self.width, 4))
+
+    def pixel(self, x: int, y: int) -> tuple[int, int, int, int]:
+        """Get the RGBA values of a pixel, (0, 0) is the top left corner."""
+        offset = (y * self.width + x) * 4
+        r, g, b, a = self.data[offset : offset + 4]
+        return r, g, b, a
+
+
+def _decode_rle(data: bytes, offset: int, size: int, depth: int) -> bytes:
+    """Decode the run-length encoded pixels of a TGA image."""
+    out = bytearray()
+    while len(out) < size:
+        packet = data[offset]
+        count = (packet & 0x7F) + 1
+        offset += 1
+        if packet & 0x80:
+            out += data[offset : offset + depth] * count
+            offset += depth
+        else:
+            out += data[offset : offset + depth * count]
+            offset += depth * count
+    return bytes(out[:size])
+
+
+def decode_tga(data: bytes) -> RGBAImage:
+    """Decode a true-color (24 or 32 bits) TGA image, uncompressed or run-length encoded.
+
+    Raises:
+        ValueError: if the image type or depth is not supported
+
+    Returns:
+        the RGBA image
+    """
+    if len(data) < _TGA_HEADER_SIZE:
+        raise ValueError("Not a TGA image, the header is incomplete")
+
+    id_length, colormap_type, image_type = data[0], data[1], data[2]
+    colormap_length = int.from_bytes(data[5:7], "little")
+    colormap_depth = data[7]
+    width = int.from_bytes(data[12:14], "little")
+    height = int.from_bytes(data[14:16], "little")
+    depth, descriptor = data[16] // 8, data[17]
+
+    if image_type not in (_TGA_UNCOMPRESSED, _TGA_RLE) or depth not in (3, 4):
+        raise ValueError(
+            f"Unsupported TGA image (type {image_type}, {depth * 8} bits), "
+            "only true-color images are supported"
+        )
+
+    offset = _TGA_HEADER_SIZE + id_length
+    if colormap_type:
+        offset += colormap_length * ((colormap_depth + 7) // 8)
+
+    pixel_count = width * height
+    size = pixel_count * depth
+    if image_type == _TGA_RLE:
+        src = _decode_rle(data, offset, size, depth)
+    else:
+        src = data[offset : offset + size]
+
+    # TGA pixels are stored as BGR(A)
+    rgba = bytearray(pixel_count * 4)
+    rgba[0::4] = src[2::depth]
+    rgba[1::4] = src[1::depth]
+    rgba[2::4] = src[0::depth]
+    rgba[3::4] = src[3::depth] if depth == 4 else b"\xff" * pixel_count
+
+    if not descriptor & _TGA_TOP_LEFT_ORIGIN:
+        stride = width * 4
+        rows = [rgba[row * stride : (row + 1) * stride] for row in range(height)]
+        rgba = bytearray(b"".join(reversed(rows)))
+
+    return RGBAImage(width, height, bytes(rgba))
+
+
+def read_tga(path: Path | str) -> RGBAImage:
+    """Read a TGA image file.
+
+    Raises:
+        ValueError: if the image type or depth is not supported
+
+    Returns:
+        the RGBA image
+    """
+    return decode_tga(Path(path).read_bytes())
+
+
+def _frame_dir_root() -> str | None:
+    """The directory of the temporary renders, a RAM disk if there's one."""
+    frame_dir = os.getenv("PYTVPAINT_FRAME_DIR")
+    if frame_dir:
+        return frame_dir
+    if Path("/dev/shm").is_dir():
+        return "/dev/shm"
+    return None
+
+
+@contextlib.contextmanager
+def frame_dir() -> Iterator[Path]:
+    """Context manager that creates a temporary directory for the rendered frames.
+
+    It's created in the `PYTVPAINT_FRAME_DIR` directory or in `/dev/shm` if it exists (a RAM disk
+    on Linux) or in the system temporary directory.
+
+    Note:
+        TVPaint must have access to that directory, so it must run on the same machine.
+
+    Yields:
+        the directory path
+    """
+    with tempfile.TemporaryDirectory(prefix="pytvpaint_", dir=_frame_dir_root()) as tmp:
+        yield Path(tmp)
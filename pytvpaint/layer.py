@@ -2,8 +2,11 @@
 
 from __future__ import annotations
 
-from collections.abc import Iterator
-from dataclasses import dataclass
+import bisect
+import contextlib
+import itertools
+from collections.abc import Iterable, Iterator
+from dataclasses import InitVar, dataclass, field
 from pathlib import Path
 from typing import TYPE_CHECKING
 from uuid import uuid4
@@ -12,7 +15,9 @@ from fileseq.filesequence import FileSequence
 from fileseq.frameset import FrameSet
 
 from pytvpaint import george, log, utils
+from pytvpaint.george.client.cache import snapshot_cache
 from pytvpaint.george.exceptions import GeorgeError
+from pytvpaint.image import RGBAImage, frame_dir, read_tga
 from pytvpaint.utils import (
     Refreshable,
     Removable,
@@ -32,17 +37,31 @@ class LayerInstance:
 
     Note:
         `LayerInstance` is special because we can't track their position, meaning that if the user move an instance the Python object values won't match.
+
+    Attributes:
+        starts_index: the instance starts of the layer the instance was found in, `next`, `previous` and `length`
+            use it instead of fetching it again until TVPaint data is modified through PyTVPaint
     """
 
     layer: Layer
     start: int
+    validate: InitVar[bool] = False
+    starts_index: list[int] | None = field(default=None, repr=False, compare=False)
+    _generation: int = field(init=False, repr=False, compare=False)
+
+    def __post_init__(self, validate: bool) -> None:
+        """Checks if the instance exists after init if `validate` is True.
 
-    def __post_init__(self) -> None:
-        """Checks if the instance exists after init.
+        Args:
+            validate: whether to check that there's an instance at the start frame. Defaults to False.
 
         Raises:
             ValueError: if no layer instance found at provided start frame
         """
+        self._generation = snapshot_cache.generation
+        if not validate:
+            return
+
         try:
             project_start_frame = self.layer.project.start_frame
             george.tv_instance_get_name(self.layer.id, self.start - project_start_frame)
@@ -75,7 +94,6 @@ class LayerInstance:
         Raises:
             ValueError: If the length provided is inferior to 1
         """
-        self.layer.make_current()
         next_instance = self.next
         end = (next_instance.start - 1) if next_instance else self.layer.end
         return (end - self.start) + 1
@@ -124,59 +142,86 @@ class LayerInstance:
                 f"`at_frame` must be in range of the instance's start-end ({self.start}-{self.end})"
             )
 
-        self.layer.make_current()
+        self.layer.clip.make_current()
         real_frame = at_frame - self.layer.project.start_frame
-        george.tv_exposure_break(real_frame)
+        george.tv_layer_exposure_break(self.layer.id, real_frame)
 
         return LayerInstance(self.layer, at_frame)
 
     def duplicate(
         self, direction: george.InsertDirection = george.InsertDirection.AFTER
     ) -> None:
-        """Duplicate the instance and insert it in the given direction."""
-        self.layer.make_current()
+        """Duplicate the instance and insert it in the given direction.
+
+        The images are copied and pasted in a single George call.
+        """
+        clip = self.layer.clip
+        clip.make_current()
 
         # tvp won't insert images if the insert frame is the same as the instance start, let's move it
-        move_frame = self.layer.clip.current_frame
-        if move_frame == self.start and self.layer.start != self.start:
+        if clip.current_frame == self.start and self.layer.start != self.start:
             move_frame = self.layer.start
         else:
             move_frame = self.layer.end + 1
 
-        with utils.restore_current_frame(self.layer.clip, move_frame):
-            self.copy()
-            at_frame = (
-                self.end if direction == george.InsertDirection.AFTER else self.start
-            )
-            self.paste(at_frame=at_frame)
+        end = self.end
+        at_frame = end if direction == george.InsertDirection.AFTER else self.start
+        project_start_frame = self.layer.project.start_frame
+
+        george.tv_exposure_duplicate(
+            self.layer.id,
+            frame=self.start - clip.start,
+            count=(end - self.start) + 1,
+            paste_frame=at_frame - project_start_frame,
+            move_frame=move_frame - project_start_frame,
+        )
 
     def cut(self) -> None:
-        """Cut all the frames/images/exposures of the instance and store them in the image buffer."""
-        self.layer.make_current()
-        self.select()
-        self.layer.cut_selection()
+        """Cut all the frames/images/exposures of the instance and store them in the image buffer.
+
+        The frames are selected and cut in a single George call.
+        """
+        self.layer.clip.make_current()
+        start, count = self._selection_range()
+        george.tv_layer_select_copy(self.layer.id, start, count, cut=True)
 
     def copy(self) -> None:
-        """Copy all the frames/images/exposures of the instance and store them in the image buffer."""
-        self.layer.make_current()
-        self.select()
-        self.layer.copy_selection()
+        """Copy all the frames/images/exposures of the instance and store them in the image buffer.
+
+        The frames are selected and copied in a single George call.
+        """
+        self.layer.clip.make_current()
+        start, count = self._selection_range()
+        george.tv_layer_select_copy(self.layer.id, start, count)
 
     def paste(self, at_frame: int | None) -> None:
         """Paste all the frames/images/exposures stored in the image buffer to the current instance at the given frame.
 
+        The current frame is restored after pasting, in a single George call.
+
         Args:
             at_frame: the frame where the stored frames will be pasted. Default is the current frame
         """
-        at_frame = at_frame if at_frame is not None else self.layer.clip.current_frame
-
-        self.layer.make_current()
-        with utils.restore_current_frame(self.layer.clip, at_frame):
-            self.layer.paste_selection()
+        self.layer.clip.make_current()
+        real_frame = None
+        if at_frame is not None:
+            real_frame = at_frame - self.layer.project.start_frame
+        george.tv_layer_paste_at(self.layer.id, real_frame)
 
     def select(self) -> None:
         """Select all frames in this instance."""
-        self.layer.select_frames(self.start, (self.length - 1))
+        self.layer.select_frames(self.start, self.end)
+
+    def _selection_range(self) -> tuple[int, int]:
+        """The start frame relative to the clip and the number of frames of the instance, to select it."""
+        return self.start - self.layer.clip.start, self.length
+
+    def _starts(self) -> list[int]:
+        """The instance starts of the layer, from the index the instance was found in if it's still valid."""
+        is_valid = self._generation == snapshot_cache.generation
+        if self.starts_index is not None and is_valid:
+            return self.starts_index
+        return self.layer.instance_starts
 
     @property
     def next(self) -> LayerInstance | None:
@@ -185,19 +230,12 @@ class LayerInstance:
         Returns:
             the next instance or None if at the end of the layer
         """
-        self.layer.make_current()
-        with utils.restore_current_frame(self.layer.clip, self.start):
-            next_frame = george.tv_exposure_next()
+        starts = self._starts()
+        index = bisect.bisect_right(starts, self.start)
 
-        next_frame += self.layer.project.start_frame
-        if next_frame > self.layer.end:
+        if index >= len(starts):
             return None
-
-        next_instance = LayerInstance(self.layer, next_frame)
-
-        if next_instance == self:
-            return None
-        return next_instance
+        return LayerInstance(self.layer, starts[index], starts_index=starts)
 
     @property
     def previous(self) -> LayerInstance | None:
@@ -206,18 +244,12 @@ class LayerInstance:
         Returns:
             the previous instance, None if there isn't
         """
-        self.layer.make_current()
-        with utils.restore_current_frame(self.layer.clip, self.start):
-            prev_frame = george.tv_exposure_prev()
-
-        prev_frame += self.layer.project.start_frame
-        prev_frame = max(self.layer.start, prev_frame)
+        starts = self._starts()
+        index = bisect.bisect_left(starts, self.start) - 1
 
-        prev_instance = LayerInstance(self.layer, prev_frame)
-
-        if prev_instance == self:
+        if index < 0:
             return None
-        return prev_instance
+        return LayerInstance(self.layer, starts[index], starts_index=starts)
 
 
 class LayerColor(Refreshable):
@@ -227,20 +259,27 @@ class LayerColor(Refreshable):
         self,
         color_index: int,
         clip: Clip | None = None,
+        data: george.TVPClipLayerColor | None = None,
     ) -> None:
-        """Construct a LayerColor from an index and a clip (if None it gets the current clip)."""
+        """Construct a LayerColor from an index and a clip (if None it gets the current clip).
+
+        The color data is fetched unless it's provided, see `Clip.layer_colors` to get all the colors at once.
+        """
         from pytvpaint.clip import Clip
 
         super().__init__()
         self._index = color_index
         self._clip = clip or Clip.current_clip()
-        self._data = george.tv_layer_color_get_color(self.clip.id, self._index)
+        self._data = data or george.tv_layer_color_get_color(self.clip.id, self._index)
 
     def refresh(self) -> None:
         """Refreshes the layer color data."""
-        if not self.refresh_on_call and self._data:
-            return
-        self._data = george.tv_layer_color_get_color(self._clip.id, self._index)
+        self._data = snapshot_cache.get(
+            ("layer_color", self._clip.id, self._index),
+            george.tv_layer_color_get_color,
+            self._clip.id,
+            self._index,
+        )
 
     def __repr__(self) -> str:
         """Returns the string representation of LayerColor."""
@@ -331,21 +370,44 @@ class LayerColor(Refreshable):
 class Layer(Removable):
     """A Layer is inside a clip and contains drawings."""
 
-    def __init__(self, layer_id: int, clip: Clip | None = None) -> None:
+    def __init__(
+        self,
+        layer_id: int,
+        clip: Clip | None = None,
+        data: george.TVPLayer | None = None,
+        validate: bool = False,
+    ) -> None:
+        """Constructs a Layer handle from an existing TVPaint layer (giving its id).
+
+        The layer data is fetched when it's first read, unless it's provided or `validate` is True.
+
+        Args:
+            layer_id: an existing layer id
+            clip: the parent clip or the current one if None
+            data: the layer data if it was already fetched. Defaults to None.
+            validate: fetch the data right away, to check that the layer exists. Defaults to False.
+
+        Raises:
+            NoObjectWithIdError: if `validate` is True and there's no layer with that id
+        """
         from pytvpaint.clip import Clip
 
         super().__init__()
         self._id = layer_id
         self._clip = clip or Clip.current_clip()
-        self._data = george.tv_layer_info(self.id)
+        self._data: george.TVPLayer
+        if data:
+            self._data = data
+        elif validate:
+            self._data = george.tv_layer_info(self.id)
 
     def refresh(self) -> None:
         """Refreshes the layer data."""
         super().refresh()
-        if not self.refresh_on_call and self._data:
-            return
         try:
-            self._data = george.tv_layer_info(self._id)
+            self._data = snapshot_cache.get(
+                ("layer", self._id), george.tv_layer_info, self._id
+            )
         except GeorgeError:
             self.mark_removed()
             self.refresh()
@@ -412,6 +474,11 @@ class Layer(Removable):
         self.make_current()
         george.tv_layer_move(value)
 
+    @refreshed_property
+    def data(self) -> george.TVPLayer:
+        """Returns the raw data of the layer, as read by `tv_layer_info`."""
+        return self._data
+
     @refreshed_property
     def name(self) -> str:
         """The layer name."""
@@ -923,6 +990,65 @@ class Layer(Removable):
 
         return export_path
 
+    def read_frame(
+        self,
+        frame: int | None = None,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = george.BackgroundMode.NONE,
+    ) -> RGBAImage:
+        """Get the pixels of the layer at the given frame.
+
+        Args:
+            frame: the frame to read or the current frame if None. Defaults to None.
+            alpha_mode: the render alpha mode
+            background_mode: the render background mode
+
+        Returns:
+            the RGBA image of the layer
+        """
+        frame = frame if frame is not None else self.clip.current_frame
+        with contextlib.closing(
+            self.read_frames(frame, frame, alpha_mode, background_mode)
+        ) as frames:
+            return next(frames)[1]
+
+    def read_frames(
+        self,
+        start: int | None = None,
+        end: int | None = None,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = george.BackgroundMode.NONE,
+    ) -> Iterator[tuple[int, RGBAImage]]:
+        """Iterate over the pixels of the layer in a frame range, one frame at a time.
+
+        Each frame is saved as an uncompressed image in a temporary directory (see `pytvpaint.image.frame_dir`)
+        and removed as soon as it's read, the render settings are applied once for the whole range.
+
+        Args:
+            start: the first frame to read or the layer's start if None. Defaults to None.
+            end: the last frame to read or the layer's end if None. Defaults to None.
+            alpha_mode: the render alpha mode
+            background_mode: the render background mode
+
+        Yields:
+            the frame and the RGBA image of the layer
+        """
+        self.make_current()
+        start = start if start is not None else self.start
+        end = end if end is not None else self.end
+        save_format = george.SaveFormat.TGA
+
+        with frame_dir() as tmp_dir, utils.render_context(
+            alpha_mode, background_mode, save_format, layer_selection=[self]
+        ), utils.restore_current_frame(self.clip, start):
+            for frame in range(start, end + 1):
+                self.clip.current_frame = frame
+                image_path = tmp_dir / f"{self.id}.{frame}.tga"
+                george.tv_save_image(image_path)
+                image = read_tga(image_path)
+                image_path.unlink()
+                yield frame, image
+
     @set_as_current
     def render_instances(
         self,
@@ -1049,20 +1175,43 @@ class Layer(Removable):
     def marks(self) -> Iterator[tuple[int, LayerColor]]:
         """Iterator over the layer marks including the frame and the color.
 
+        The marks are fetched in a single George call, and the clip colors in another one.
+
         Yields:
             frame (int): the mark frame
             color (LayerColor): the mark color
         """
-        for frame in range(self.start, self.end + 1):
-            layer_color = self.get_mark_color(frame)
-            if not layer_color:
-                continue
-            yield (frame, layer_color)
+        start_frame = self.project.start_frame
+        marks = george.tv_layer_marks_enum(
+            [(self.id, self.start - start_frame, self.end - start_frame)]
+        )
+
+        colors = list(self.clip.layer_colors) if marks else []
+        for _, frame, color_index in marks:
+            yield (frame + start_frame, colors[color_index])
 
     def clear_marks(self) -> None:
-        """Clear all the marks in the layer."""
-        for frame, _ in self.marks:
-            self.remove_mark(frame)
+        """Clear all the marks in the layer, the marks are removed in a single batch.
+
+        Raises:
+            TypeError: if the layer is not an animation layer
+        """
+        start_frame = self.project.start_frame
+        marks = george.tv_layer_marks_enum(
+            [(self.id, self.start - start_frame, self.end - start_frame)]
+        )
+        if not marks:
+            return
+
+        if not self.is_anim_layer:
+            raise TypeError(
+                f"Can't remove the marks because this is not an animation layer ({self})"
+            )
+
+        with george.batch():
+            for _, frame, _ in marks:
+                # Setting it at 0 clears the mark
+                george.tv_layer_mark_set(self.id, frame, 0)
 
     @set_as_current
     def select_frames(self, start: int, end: int) -> None:
@@ -1116,25 +1265,35 @@ class Layer(Removable):
         """Paste the previously copied instances."""
         george.tv_layer_paste()
 
-    @refreshed_property
+    @property
     @set_as_current
+    def instance_starts(self) -> list[int]:
+        """The sorted start frames of the layer instances, used as an index for instance lookups.
+
+        They are fetched in a single George call and stored in the snapshot cache like the layer data,
+        the instances returned by the layer keep the index they were found in for their own lookups.
+        """
+        self.refresh()
+        first_frame, last_frame = self._data.first_frame, self._data.last_frame
+        relative_starts = snapshot_cache.get(
+            ("layer_instances", self._id, first_frame, last_frame),
+            george.tv_exposure_enum_starts,
+            first_frame,
+            last_frame,
+        )
+        start_frame = self.project.start_frame
+        return [start + start_frame for start in relative_starts]
+
+    @property
     def instances(self) -> Iterator[LayerInstance]:
         """Iterates over the layer instances.
 
         Yields:
             each LayerInstance present in the layer
         """
-        # instances start at layer start
-        current_instance = LayerInstance(self, self.start)
-
-        while True:
-            yield current_instance
-
-            nex_instance = current_instance.next
-            if nex_instance is None:
-                break
-
-            current_instance = nex_instance
+        starts = self.instance_starts
+        for start in starts:
+            yield LayerInstance(self, start, starts_index=starts)
 
     def get_instance(self, frame: int, strict: bool = False) -> LayerInstance | None:
         """Get the instance at that frame.
@@ -1146,17 +1305,20 @@ class Layer(Removable):
         Returns:
             the instance if found else None
         """
-        for layer_instance in self.instances:
-            if strict:
-                if layer_instance.start != frame:
-                    continue
-                return layer_instance
+        starts = self.instance_starts
+        index = bisect.bisect_right(starts, frame) - 1
+        if index < 0:
+            return None
 
-            if not (layer_instance.start <= frame <= layer_instance.end):
-                continue
-            return layer_instance
+        start = starts[index]
+        if strict and start != frame:
+            return None
+
+        end = (starts[index + 1] - 1) if index + 1 < len(starts) else self.end
+        if frame > end:
+            return None
 
-        return None
+        return LayerInstance(self, start, starts_index=starts)
 
     def get_instances(self, from_frame: int, to_frame: int) -> Iterator[LayerInstance]:
         """Iterates over the layer instances and returns the one in the range (from_frame-to_frame).
@@ -1164,13 +1326,69 @@ class Layer(Removable):
         Yields:
             each LayerInstance in the range (from_frame-to_frame)
         """
-        for layer_instance in self.instances:
-            if layer_instance.end < from_frame:
-                continue
-            if from_frame <= layer_instance.start <= to_frame:
-                yield layer_instance
-            if layer_instance.start > to_frame:
-                break
+        starts = self.instance_starts
+        first = bisect.bisect_left(starts, from_frame)
+        last = bisect.bisect_right(starts, to_frame)
+
+        for start in starts[first:last]:
+            yield LayerInstance(self, start, starts_index=starts)
+
+    def retime(self, timings: Iterable[tuple[int, int]]) -> list[LayerInstance]:
+        """Set the number of frames of several instances at once, in a single George call and undo stack.
+
+        The new starts of the instances are computed from the instance index, the instances that already
+        have the given length are not changed and the following instances are shifted by TVPaint.
+
+        Example:
+            ```python
+            # Hold every instance two frames
+            layer.retime((instance.start, 2) for instance in layer.instances)
+            ```
+
+        Args:
+            timings: the start frames of the instances and their new number of frames
+
+        Raises:
+            ValueError: if a length is inferior to 1 or if there's no instance at a start frame
+
+        Returns:
+            the instances of the layer after retiming
+        """
+        with snapshot_cache.freeze():
+            starts = self.instance_starts
+            if not starts:
+                return []
+
+            ends = [start - 1 for start in starts[1:]] + [self.end]
+            lengths = {start: end - start + 1 for start, end in zip(starts, ends)}
+
+            new_lengths = dict(lengths)
+            for start, length in timings:
+                if length < 1:
+                    raise ValueError("Instance Length must be at least equal to 1")
+                if start not in lengths:
+                    raise ValueError(f"There's no instance at frame {start}")
+                new_lengths[start] = length
+
+            changed = [
+                start for start in starts if new_lengths[start] != lengths[start]
+            ]
+            if changed:
+                self.clip.make_current()
+                start_frame = self.project.start_frame
+                exposures = [
+                    (start - start_frame, new_lengths[start]) for start in changed
+                ]
+                george.tv_layer_exposures_set(self.id, exposures, "retime")
+
+        new_starts = list(
+            itertools.accumulate(
+                (new_lengths[start] for start in starts[:-1]), initial=starts[0]
+            )
+        )
+        return [
+            LayerInstance(self, start, starts_index=new_starts) for start in new_starts
+        ]
 
     def add_instance(
         self,
@@ -1210,23 +1428,17 @@ class Layer(Removable):
         start = start if start is not None else self.clip.current_frame
         self.clip.make_current()
 
-        temp_layer = Layer.new_anim_layer(str(uuid4()))
-        temp_layer.make_current()
-
-        with utils.restore_current_frame(self.clip, 1):
-            if nb_frames > 1:
-                if split:
-                    george.tv_layer_insert_image(count=nb_frames, direction=direction)
-                else:
-                    layer_instance = next(temp_layer.instances)
-                    layer_instance.length = nb_frames
-
-            temp_layer.select_all_frames()
-            temp_layer.copy_selection()
-            self.clip.current_frame = start
-            self.make_current()
-            self.paste_selection()
-            temp_layer.remove()
+        # the instance is made in a temporary layer and copied, all in a single George call
+        project_start_frame = self.project.start_frame
+        george.tv_layer_add_instance(
+            self.id,
+            temp_layer_name=str(uuid4()),
+            temp_frame=1 - project_start_frame,
+            frame=start - project_start_frame,
+            count=nb_frames,
+            direction=direction,
+            split=split,
+        )
 
         return LayerInstance(self, start)
 
@@ -2,15 +2,17 @@
 
 from __future__ import annotations
 
-from collections.abc import Iterator
+from collections.abc import Iterable, Iterator
+from dataclasses import dataclass, field
 from pathlib import Path
 from typing import TYPE_CHECKING
 
 from fileseq.filesequence import FileSequence
 
 from pytvpaint import george, utils
+from pytvpaint.george.client.cache import snapshot_cache
 from pytvpaint.george.exceptions import GeorgeError
-from pytvpaint.sound import ProjectSound
+from pytvpaint.sound import ClipSound, ProjectSound
 from pytvpaint.utils import (
     Refreshable,
     Renderable,
@@ -20,20 +22,92 @@ from pytvpaint.utils import (
 
 if TYPE_CHECKING:
     from pytvpaint.clip import Clip
+    from pytvpaint.query import ProjectQuery
+    from pytvpaint.render import RenderDispatcher, StructureExport, StructureFormat
     from pytvpaint.scene import Scene
 
 
+@dataclass(frozen=True)
+class ProjectIndex:
+    """Index of the scenes and clips of a project, to find a clip's scene and position in O(1).
+
+    Attributes:
+        scenes: the scene ids with their clip ids, in position order
+    """
+
+    scenes: list[tuple[int, list[int]]]
+    _clips: dict[int, tuple[int, int]] = field(init=False, repr=False)
+
+    def __post_init__(self) -> None:
+        """Builds the lookup table of the clips scene and position."""
+        clips = {
+            clip_id: (scene_id, position)
+            for scene_id, clip_ids in self.scenes
+            for position, clip_id in enumerate(clip_ids)
+        }
+        object.__setattr__(self, "_clips", clips)
+
+    @property
+    def scene_ids(self) -> list[int]:
+        """The scene ids, in position order."""
+        return [scene_id for scene_id, _ in self.scenes]
+
+    @property
+    def clip_ids(self) -> list[int]:
+        """The ids of all the clips, in scene and position order."""
+        return list(self._clips)
+
+    def has_clip(self, clip_id: int) -> bool:
+        """Returns True if the clip is in the project."""
+        return clip_id in self._clips
+
+    def clip_scene_id(self, clip_id: int) -> int:
+        """Get the id of the clip's scene.
+
+        Raises:
+            ValueError: if the clip is not in the project
+        """
+        return self._clip_location(clip_id)[0]
+
+    def clip_position(self, clip_id: int) -> int:
+        """Get the position of the clip in its scene.
+
+        Raises:
+            ValueError: if the clip is not in the project
+        """
+        return self._clip_location(clip_id)[1]
+
+    def _clip_location(self, clip_id: int) -> tuple[int, int]:
+        try:
+            return self._clips[clip_id]
+        except KeyError:
+            raise ValueError(f"No clip found open with id : {clip_id}")
+
+
 class Project(Refreshable, Renderable):
     """A TVPaint project is the highest object that contains everything in the data hierarchy.
 
     It looks like this: Project -> Scene -> Clip -> Layer -> LayerInstance
     """
 
-    def __init__(self, project_id: str) -> None:
+    def __init__(self, project_id: str, validate: bool = False) -> None:
+        """Constructs a Project from an open TVPaint project (giving its id).
+
+        The project data is fetched when it's first read, unless `validate` is True.
+
+        Args:
+            project_id: an open project id
+            validate: fetch the data right away, to check that the project is open. Defaults to False.
+
+        Raises:
+            NoObjectWithIdError: if `validate` is True and there's no project with that id
+        """
         super().__init__()
         self._id = project_id
         self._is_closed = False
-        self._data = george.tv_project_info(self._id)
+        self._data: george.TVPProject
+        if validate:
+            self._data = george.tv_project_info(self._id)
 
     def __repr__(self) -> str:
         """String representation of the project."""
@@ -54,10 +128,9 @@ class Project(Refreshable, Renderable):
         if self._is_closed:
             msg = "Project already closed, load the project again to get data"
             raise ValueError(msg)
-        if not self.refresh_on_call and self._data:
-            return
-
-        self._data = george.tv_project_info(self._id)
+        self._data = snapshot_cache.get(
+            ("project", self._id), george.tv_project_info, self._id
+        )
 
     @property
     def id(self) -> str:
@@ -377,6 +450,34 @@ class Project(Refreshable, Renderable):
 
         return Clip.current_clip()
 
+    @property
+    @set_as_current
+    def index(self) -> ProjectIndex:
+        """The index of the project's scenes and clips.
+
+        It's fetched in a single George call and stored in the snapshot cache, use
+        `pytvpaint.cached` to build the index once for many lookups.
+        """
+        return snapshot_cache.get(
+            ("project_index", self._id),
+            lambda: ProjectIndex(george.tv_scene_clips_enum()),
+        )
+
+    @property
+    def query(self) -> ProjectQuery:
+        """The indexed query over the project's clips and layers, to filter layers on their info and color.
+
+        Its snapshot is fetched in a single George call that selects every clip in turn and reads
+        the info of every layer of the project. Outside of `pytvpaint.cached` (or with no cache TTL)
+        each access fetches it again, so keep the returned query for many lookups, or use a cached
+        context where it's fetched again only after a change made through PyTVPaint.
+        """
+        from pytvpaint.query import ProjectQuery
+
+        return snapshot_cache.get(
+            ("project_query", self._id), lambda: ProjectQuery.fetch(self)
+        )
+
     @property
     def clips(self) -> Iterator[Clip]:
         """Iterates over all the clips in the project's scenes."""
@@ -386,13 +487,14 @@ class Project(Refreshable, Renderable):
     @property
     @set_as_current
     def clip_names(self) -> Iterator[str]:
-        """Optimized way to get the clip names. Useful for `get_unique_name`."""
-        for scene_id in self.current_scene_ids():
-            clip_ids = utils.position_generator(
-                lambda pos: george.tv_clip_enum_id(scene_id, pos)
-            )
-            for clip_id in clip_ids:
-                yield george.tv_clip_name_get(clip_id)
+        """Optimized way to get the clip names, they're fetched in a single George call. Useful for `get_unique_name`."""
+        for _, _, clip_name in self._clip_names_enum():
+            yield clip_name
+
+    @set_as_current
+    def _clip_names_enum(self) -> list[tuple[int, int, str]]:
+        """The scene id, id and name of each clip, stored in the snapshot cache like the index."""
+        return snapshot_cache.get(("clip_names", self._id), george.tv_clip_names_enum)
 
     def get_clip(
         self,
@@ -400,15 +502,28 @@ class Project(Refreshable, Renderable):
         by_name: str | None = None,
         scene_id: int | None = None,
     ) -> Clip | None:
-        """Find a clip by id, name or scene_id."""
-        clips = self.clips
-        if scene_id:
-            selected_scene = self.get_scene(by_id=scene_id)
-            clips = selected_scene.clips if selected_scene else clips
+        """Find a clip by id, name or scene_id.
 
-        for clip in clips:
-            if (by_id and clip.id == by_id) or (by_name and clip.name == by_name):
-                return clip
+        The clips are looked up in the project index, their names are fetched in a single George call.
+        """
+        from pytvpaint.clip import Clip
+
+        index = self.index
+        clip_ids = index.clip_ids
+        if scene_id and scene_id in index.scene_ids:
+            clip_ids = dict(index.scenes)[scene_id]
+
+        matches = {by_id} if by_id else set()
+        if by_name:
+            matches.update(
+                clip_id
+                for _, clip_id, clip_name in self._clip_names_enum()
+                if clip_name == by_name
+            )
+
+        for clip_id in clip_ids:
+            if clip_id in matches:
+                return Clip(clip_id, project=self)
 
         return None
 
@@ -419,13 +534,32 @@ class Project(Refreshable, Renderable):
 
     @property
     def sounds(self) -> Iterator[ProjectSound]:
-        """Iterator over the project sounds."""
-        sounds_data_iter = utils.position_generator(
-            lambda pos: george.tv_sound_project_info(self.id, pos)
-        )
+        """Iterator over the project sounds, their data is fetched in a single George call."""
+        for track_index, data in enumerate(ProjectSound.iter_sounds_data(self.id)):
+            yield ProjectSound(track_index, project=self, data=data)
 
-        for track_index, _ in enumerate(sounds_data_iter):
-            yield ProjectSound(track_index, project=self)
+    @set_as_current
+    def clip_sounds_snapshot(self) -> list[tuple[Clip, list[ClipSound]]]:
+        """Get the soundtracks of all the clips of the project with their data fetched in a single George call.
+
+        It's much faster than iterating over `Clip.sounds` for each clip of a project with many clips.
+
+        Returns:
+            the clips with their soundtracks, in the order of the project clips
+        """
+        from pytvpaint.clip import Clip
+
+        clip_sounds = []
+        for clip_id, sounds_data in george.tv_sound_clip_info_project():
+            snapshot_cache.put((ClipSound.__name__, clip_id), sounds_data)
+            clip = Clip(clip_id, project=self)
+            sounds = [
+                ClipSound(track_index, clip=clip, data=data)
+                for track_index, data in enumerate(sounds_data)
+            ]
+            clip_sounds.append((clip, sounds))
+
+        return clip_sounds
 
     def add_sound(self, sound_path: Path | str) -> ProjectSound:
         """Add a new sound clip to the project."""
@@ -529,6 +663,46 @@ class Project(Refreshable, Renderable):
             format_opts,
         )
 
+    @set_as_current
+    def export_structures(
+        self,
+        output_dir: Path | str,
+        formats: Iterable[StructureFormat],
+        clips: Iterable[Clip] | None = None,
+        save_format: george.SaveFormat = george.SaveFormat.PNG,
+        dispatcher: RenderDispatcher | None = None,
+    ) -> list[StructureExport]:
+        """Export the structure of clips in several formats (JSON, PSD, CSV, sprites, Flix) in one pipeline.
+
+        The exports share a single render session and their outputs are verified on a thread pool while TVPaint
+        keeps exporting, see `pytvpaint.render.export_structures` for the output paths.
+
+        Args:
+            output_dir: the output folder
+            formats: the export formats
+            clips: the clips to export, all the clips of the project if None. Defaults to None.
+            save_format: the image format of the exports. Defaults to george.SaveFormat.PNG.
+            dispatcher: spread the clips over the TVPaint instances of a dispatcher, they load the project
+                from its saved file. Defaults to None.
+
+        Raises:
+            FileNotFoundError: if an export failed or is incomplete
+            ValueError: if an exported JSON or CSV file can't be parsed
+
+        Returns:
+            the verified exports, in the order of the clips then the formats
+        """
+        from pytvpaint.render import export_structures
+
+        clips = list(clips) if clips is not None else list(self.clips)
+        if dispatcher:
+            clip_names = [clip.name for clip in clips]
+            return dispatcher.export_structures(
+                self.path, output_dir, formats, clip_names, save_format
+            )
+
+        return export_structures(clips, output_dir, formats, save_format)
+
     @staticmethod
     def current_project_id() -> str:
         """Returns the current project id."""
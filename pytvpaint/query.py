@@ -0,0 +1,332 @@
+"""Indexed queries over a snapshot of the clips and layers of a project, to find elements without an RPC per candidate.
+
+Example:
+    ```python
+    from pytvpaint.project import Project
+    from pytvpaint.query import anim, color, name, visible
+
+    project = Project.current_project()
+
+    # The snapshot is fetched in a single George call, keep the query for many lookups
+    query = project.query
+    for layer in query.layers(where=visible & anim & (color == 3)):
+        print(layer.clip.name, layer.name)
+
+    layer = query.layer(by_name="character", clip=project.get_clip(by_name="shot_010"))
+    ```
+"""
+
+from __future__ import annotations
+
+import re
+from collections import defaultdict
+from collections.abc import Iterable
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING, Any, Callable
+
+from pytvpaint import george, utils
+from pytvpaint.george.client.cache import snapshot_cache
+
+if TYPE_CHECKING:
+    from pytvpaint.clip import Clip
+    from pytvpaint.layer import Layer
+    from pytvpaint.project import Project
+
+
+@dataclass(frozen=True)
+class LayerRecord:
+    """The snapshot of a layer, the predicates of a query are evaluated on it.
+
+    Attributes:
+        clip_id: the id of the layer's clip
+        info: the layer info
+        color_index: the index of the layer color in the clip colors
+    """
+
+    clip_id: int
+    info: george.TVPLayer
+    color_index: int
+
+    @property
+    def id(self) -> int:
+        """The layer id."""
+        return self.info.id
+
+    @property
+    def name(self) -> str:
+        """The layer name."""
+        return self.info.name
+
+
+class Predicate:
+    """A condition on a layer record, predicates are combined with `&`, `|` and `~`.
+
+    Warning:
+        In Python `&` and `|` take precedence over comparisons, so use parentheses around them:
+        `visible & (color == 3)`.
+    """
+
+    def __init__(self, test: Callable[[LayerRecord], bool]) -> None:
+        """Construct a predicate from a function that tests a layer record."""
+        self._test = test
+
+    def __call__(self, record: LayerRecord) -> bool:
+        """Returns True if the layer record matches the predicate."""
+        return self._test(record)
+
+    def __and__(self, other: Predicate) -> Predicate:
+        """Both predicates must match."""
+        return Predicate(lambda record: self(record) and other(record))
+
+    def __or__(self, other: Predicate) -> Predicate:
+        """Any of the predicates must match."""
+        return Predicate(lambda record: self(record) or other(record))
+
+    def __invert__(self) -> Predicate:
+        """The predicate must not match."""
+        return Predicate(lambda record: not self(record))
+
+
+class Field:
+    """A value of the layer records, comparing it makes a `Predicate`."""
+
+    def __init__(self, get: Callable[[LayerRecord], Any]) -> None:
+        """Construct a field from a function that gets the value from a layer record."""
+        self._get = get
+
+    def __eq__(self, value: object) -> Predicate:  # type: ignore[override]
+        """The field value is equal to the value."""
+        return Predicate(lambda record: bool(self._get(record) == value))
+
+    def __ne__(self, value: object) -> Predicate:  # type: ignore[override]
+        """The field value is different from the value."""
+        return Predicate(lambda record: bool(self._get(record) != value))
+
+    def __lt__(self, value: Any) -> Predicate:
+        """The field value is lower than the value."""
+        return Predicate(lambda record: bool(self._get(record) < value))
+
+    def __le__(self, value: Any) -> Predicate:
+        """The field value is lower than or equal to the value."""
+        return Predicate(lambda record: bool(self._get(record) <= value))
+
+    def __gt__(self, value: Any) -> Predicate:
+        """The field value is greater than the value."""
+        return Predicate(lambda record: bool(self._get(record) > value))
+
+    def __ge__(self, value: Any) -> Predicate:
+        """The field value is greater than or equal to the value."""
+        return Predicate(lambda record: bool(self._get(record) >= value))
+
+    __hash__ = None  # type: ignore[assignment]
+
+    def isin(self, values: Iterable[Any]) -> Predicate:
+        """The field value is one of the values."""
+        allowed = set(values)
+        return Predicate(lambda record: self._get(record) in allowed)
+
+    def matches(self, pattern: str) -> Predicate:
+        """The field value matches the regular expression (with `re.search`)."""
+        regex = re.compile(pattern)
+        return Predicate(lambda record: bool(regex.search(str(self._get(record)))))
+
+
+visible = Predicate(lambda record: record.info.visibility)
+selected = Predicate(lambda record: record.info.selected)
+editable = Predicate(lambda record: record.info.editable)
+anim = Predicate(lambda record: record.info.type == george.LayerType.SEQUENCE)
+
+name = Field(lambda record: record.info.name)
+color = Field(lambda record: record.color_index)
+position = Field(lambda record: record.info.position)
+opacity = Field(lambda record: record.info.density)
+layer_type = Field(lambda record: record.info.type)
+clip_id = Field(lambda record: record.clip_id)
+
+
+@dataclass(frozen=True)
+class ProjectQuery:
+    """Name to id indexes of the clips and layers of a project, built from a snapshot fetched in a single George call.
+
+    The lookups don't send any George command, except to build the returned objects' parents. The
+    snapshot is not updated, get a new query from `Project.query` after a change. Fetching it selects
+    every clip in turn, so prefer `Project.get_clip` and `Clip.get_layer` for simple lookups.
+
+    Attributes:
+        project: the queried project
+        clips: the clips with their layers, in scene and position order
+        generation: the snapshot cache generation when the snapshot was fetched
+    """
+
+    project: Project
+    clips: list[george.TVPClipLayers]
+    generation: int = 0
+    _clips_by_id: dict[int, george.TVPClipLayers] = field(init=False, repr=False)
+    _clip_ids_by_name: dict[str, list[int]] = field(init=False, repr=False)
+    _records: list[LayerRecord] = field(init=False, repr=False)
+    _records_by_id: dict[int, LayerRecord] = field(init=False, repr=False)
+    _layer_ids_by_name: dict[str, list[int]] = field(init=False, repr=False)
+
+    def __post_init__(self) -> None:
+        """Builds the lookup tables of the clips and layers."""
+        clip_ids_by_name: dict[str, list[int]] = defaultdict(list)
+        layer_ids_by_name: dict[str, list[int]] = defaultdict(list)
+        records = []
+
+        for clip in self.clips:
+            clip_ids_by_name[clip.clip_name.lower()].append(clip.clip_id)
+            for info, color_index in zip(clip.layers, clip.color_indices):
+                records.append(LayerRecord(clip.clip_id, info, color_index))
+                layer_ids_by_name[info.name.lower()].append(info.id)
+
+        object.__setattr__(self, "_clips_by_id", {c.clip_id: c for c in self.clips})
+        object.__setattr__(self, "_clip_ids_by_name", dict(clip_ids_by_name))
+        object.__setattr__(self, "_records", records)
+        object.__setattr__(self, "_records_by_id", {r.id: r for r in records})
+        object.__setattr__(self, "_layer_ids_by_name", dict(layer_ids_by_name))
+
+    @classmethod
+    def fetch(cls, project: Project) -> ProjectQuery:
+        """Fetch the snapshot of a project in a single George call, the project is made current."""
+        project.make_current()
+        generation = snapshot_cache.generation
+        return cls(project, george.tv_clip_layers_enum(), generation)
+
+    @property
+    def is_stale(self) -> bool:
+        """Returns True if TVPaint data was modified through PyTVPaint since the snapshot was fetched."""
+        return self.generation != snapshot_cache.generation
+
+    @property
+    def clip_names(self) -> list[str]:
+        """The names of all the clips, in scene and position order."""
+        return [clip.clip_name for clip in self.clips]
+
+    def clip_name(self, clip_id: int) -> str | None:
+        """The name of a clip, None if it's not in the snapshot."""
+        clip_layers = self._clips_by_id.get(clip_id)
+        return clip_layers.clip_name if clip_layers else None
+
+    def layer_names(self, clip: Clip | int) -> list[str]:
+        """The names of the layers of a clip, in position order."""
+        clip_layers = self._clips_by_id.get(_clip_id(clip))
+        return [layer.name for layer in clip_layers.layers] if clip_layers else []
+
+    def unique_clip_name(self, stub: str) -> str:
+        """Get a clip name that is not used in the project, see `utils.get_unique_name`."""
+        return utils.get_unique_name(self.clip_names, stub)
+
+    def unique_layer_name(self, clip: Clip | int, stub: str) -> str:
+        """Get a layer name that is not used in the clip, see `utils.get_unique_name`."""
+        return utils.get_unique_name(self.layer_names(clip), stub)
+
+    def clip_ids(self, by_name: str, scene_id: int | None = None) -> list[int]:
+        """Get the ids of the clips with that name (case-insensitive), optionally in a scene."""
+        clip_ids = self._clip_ids_by_name.get(by_name.lower(), [])
+        if scene_id is None:
+            return list(clip_ids)
+        return [i for i in clip_ids if self._clips_by_id[i].scene_id == scene_id]
+
+    def clip(self, by_name: str, scene_id: int | None = None) -> Clip | None:
+        """Find a clip by name (case-insensitive), the first one in scene and position order."""
+        from pytvpaint.clip import Clip
+
+        clip_ids = self.clip_ids(by_name, scene_id)
+        return Clip(clip_ids[0], project=self.project) if clip_ids else None
+
+    def records(
+        self,
+        where: Predicate | None = None,
+        clip: Clip | int | None = None,
+    ) -> list[LayerRecord]:
+        """Get the snapshot of the layers matching the predicate.
+
+        Args:
+            where: the condition on the layers, all the layers if None. Defaults to None.
+            clip: only get the layers of this clip (or clip id). Defaults to None.
+
+        Returns:
+            the layer records, in clip and position order
+        """
+        records: Iterable[LayerRecord] = self._records
+        if clip is not None:
+            clip_layer_id = _clip_id(clip)
+            records = (r for r in records if r.clip_id == clip_layer_id)
+        return [record for record in records if where is None or where(record)]
+
+    def layers(
+        self,
+        where: Predicate | None = None,
+        clip: Clip | int | None = None,
+    ) -> list[Layer]:
+        """Get the layers matching the predicate, they're built from the snapshot data.
+
+        Args:
+            where: the condition on the layers, all the layers if None. Defaults to None.
+            clip: only get the layers of this clip (or clip id). Defaults to None.
+
+        Returns:
+            the layers, in clip and position order
+        """
+        return self._make_layers(self.records(where, clip))
+
+    def layer(
+        self,
+        by_id: int | None = None,
+        by_name: str | None = None,
+        clip: Clip | int | None = None,
+    ) -> Layer | None:
+        """Find a layer by id or name (case-insensitive), the first one in clip and position order.
+
+        Args:
+            by_id: search by id. Defaults to None.
+            by_name: search by name. Defaults to None.
+            clip: only search in this clip (or clip id). Defaults to None.
+
+        Raises:
+            ValueError: if none of the arguments `by_id` and `by_name` were provided
+
+        Returns:
+            the found layer, None if there's no layer with that id or name
+        """
+        if by_id is None and by_name is None:
+            raise ValueError(
+                "At least one of the values (id or name) must be provided, none found !"
+            )
+
+        if by_id is not None:
+            candidates = [by_id]
+        else:
+            candidates = self._layer_ids_by_name.get(str(by_name).lower(), [])
+
+        records = [
+            record
+            for record in map(self._records_by_id.get, candidates)
+            if record is not None
+        ]
+        if by_id is not None and by_name is not None:
+            records = [r for r in records if r.name.lower() == by_name.lower()]
+        if clip is not None:
+            records = [r for r in records if r.clip_id == _clip_id(clip)]
+
+        layers = self._make_layers(records[:1])
+        return layers[0] if layers else None
+
+    def _make_layers(self, records: list[LayerRecord]) -> list[Layer]:
+        """Build the layer objects of the records, their data is stored in the snapshot cache."""
+        from pytvpaint.clip import Clip
+        from pytvpaint.layer import Layer
+
+        clip_ids = {record.clip_id for record in records}
+        clips = {clip_id: Clip(clip_id, project=self.project) for clip_id in clip_ids}
+
+        layers = []
+        for record in records:
+            snapshot_cache.put(("layer", record.id), record.info)
+            clip = clips[record.clip_id]
+            layers.append(Layer(record.id, clip=clip, data=record.info))
+        return layers
+
+
+def _clip_id(clip: Clip | int) -> int:
+    return clip if isinstance(clip, int) else clip.id
@@ -0,0 +1,803 @@
+"""Render dispatcher that distributes the rendering of clips across several TVPaint instances."""
+
+from __future__ import annotations
+
+import bisect
+import contextlib
+import csv
+import dataclasses
+import hashlib
+import json
+import math
+import queue
+from collections.abc import Iterable, Iterator, Mapping, Sequence
+from concurrent.futures import Future, ThreadPoolExecutor
+from dataclasses import dataclass, field
+from enum import Enum
+from pathlib import Path
+from types import TracebackType
+from typing import Any
+
+from fileseq.filesequence import FileSequence
+from fileseq.frameset import FrameSet
+
+from pytvpaint import george, log
+from pytvpaint.clip import Clip
+from pytvpaint.george.client import create_client, use_client
+from pytvpaint.george.client.cache import snapshot_cache
+from pytvpaint.george.client.rpc import JSONRPCClient
+from pytvpaint.layer import Layer
+from pytvpaint.project import Project
+from pytvpaint.utils import (
+    check_sequence_on_disk,
+    handle_output_range,
+    render_session,
+)
+
+
+def split_file_sequence(
+    file_sequence: FileSequence, chunk_size: int
+) -> list[FileSequence]:
+    """Split a file sequence into contiguous chunks of frames.
+
+    Args:
+        file_sequence: the file sequence with a frame range
+        chunk_size: the maximum number of frames of each chunk
+
+    Raises:
+        ValueError: if the chunk size is not positive or the sequence has no frame range
+
+    Returns:
+        the file sequences of each chunk, in frame order
+    """
+    if chunk_size < 1:
+        raise ValueError(f"Chunk size must be superior to 0, got {chunk_size}")
+
+    frame_set = file_sequence.frameSet()
+    if not frame_set:
+        raise ValueError(f"File sequence has no frame range: {file_sequence}")
+
+    frames = list(frame_set)
+    chunks = []
+    for index in range(0, len(frames), chunk_size):
+        chunk_frames = frames[index : index + chunk_size]
+        chunk = file_sequence.copy()
+        chunk.setFrameSet(FrameSet(chunk_frames))
+        chunks.append(chunk)
+
+    return chunks
+
+
+def frame_runs(frames: Iterable[int]) -> list[tuple[int, int]]:
+    """Group frames into ranges of consecutive frames.
+
+    Args:
+        frames: the frames, in any order
+
+    Returns:
+        the start and end frames of each range, in frame order
+    """
+    runs: list[tuple[int, int]] = []
+    for frame in sorted(set(frames)):
+        if runs and runs[-1][1] == frame - 1:
+            runs[-1] = (runs[-1][0], frame)
+        else:
+            runs.append((frame, frame))
+    return runs
+
+
+def _digest(value: Any) -> str:
+    """Hash a JSON serializable value, enums and others are serialized as strings."""
+    serialized = json.dumps(value, sort_keys=True, default=str)
+    return hashlib.sha1(serialized.encode("utf-8")).hexdigest()
+
+
+@dataclass
+class RenderManifest:
+    """The inputs of each frame of an image sequence, stored next to the rendered files.
+
+    Attributes:
+        path: the manifest file path
+        settings: the hash of the render settings (format, alpha, camera...)
+        frames: the hash of the inputs of each rendered frame
+    """
+
+    path: Path
+    settings: str = ""
+    frames: dict[int, str] = field(default_factory=dict)
+
+    @staticmethod
+    def path_for(file_sequence: FileSequence) -> Path:
+        """The manifest path of an image sequence, like `out/shot.manifest.json` for `out/shot.#.png`."""
+        basename = file_sequence.basename().rstrip("._-")
+        return Path(file_sequence.dirname(), f"{basename or 'render'}.manifest.json")
+
+    @classmethod
+    def load(cls, path: Path | str) -> RenderManifest:
+        """Load a manifest, it's empty if the file doesn't exist or is invalid."""
+        path = Path(path)
+        try:
+            content = json.loads(path.read_text(encoding="utf-8"))
+            frames = {int(frame): str(key) for frame, key in content["frames"].items()}
+            return cls(path, str(content["settings"]), frames)
+        except (OSError, ValueError, KeyError, TypeError, AttributeError):
+            return cls(path)
+
+    def save(self) -> None:
+        """Write the manifest file."""
+        content = {
+            "settings": self.settings,
+            "frames": {str(frame): key for frame, key in sorted(self.frames.items())},
+        }
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self.path.write_text(json.dumps(content, indent=2), encoding="utf-8")
+
+    def outdated_frames(
+        self, settings: str, frames: Mapping[int, str], file_sequence: FileSequence
+    ) -> list[int]:
+        """Get the frames that must be rendered again.
+
+        Args:
+            settings: the hash of the current render settings
+            frames: the hash of the current inputs of each frame
+            file_sequence: the rendered image sequence
+
+        Returns:
+            the frames whose inputs changed or which are missing on disk
+        """
+        return [
+            frame
+            for frame, key in frames.items()
+            if settings != self.settings
+            or self.frames.get(frame) != key
+            or not Path(file_sequence.frame(frame)).exists()
+        ]
+
+
+def _layer_frame_inputs(layer: Layer, start: int, end: int) -> dict[int, Any]:
+    """Get the inputs of a layer for each frame: its settings and the displayed instance."""
+    data = layer.data
+    settings = [data.name, data.density, data.type, data.stencil_state]
+    settings += [layer.blending_mode, layer.pre_behavior, layer.post_behavior]
+
+    starts = layer.instance_starts
+    real_starts = [frame - layer.project.start_frame for frame in starts]
+    names = dict(zip(starts, george.tv_instance_names_enum(layer.id, real_starts)))
+
+    def instance_at(frame: int) -> Any:
+        index = bisect.bisect_right(starts, frame) - 1
+        return (starts[index], names[starts[index]]) if index >= 0 else None
+
+    inputs: dict[int, Any] = {}
+    for frame in range(start, end + 1):
+        if not starts:
+            displayed = None
+        elif layer.start <= frame <= layer.end:
+            displayed = instance_at(frame)
+        else:
+            before = frame < layer.start
+            behavior = layer.pre_behavior if before else layer.post_behavior
+            if behavior == george.LayerBehavior.NONE:
+                displayed = None
+            elif behavior == george.LayerBehavior.HOLD:
+                displayed = instance_at(max(layer.start, min(frame, layer.end)))
+            else:
+                # repeated instances depend on the whole layer, keep the frame in the inputs
+                displayed = (behavior, frame, list(names.items()))
+        inputs[frame] = [settings, displayed]
+
+    return inputs
+
+
+def frame_signatures(
+    clip: Clip,
+    start: int,
+    end: int,
+    use_camera: bool = False,
+    layer_selection: list[Layer] | None = None,
+) -> dict[int, str]:
+    """Hash the inputs of each frame of a clip: the visible layers and their displayed instances.
+
+    It covers the layers settings (name, opacity, blending, behaviors...), the instances starts and
+    names, and the camera if it's used. Drawing on an existing instance doesn't change its inputs,
+    name the instances (or force the render) to detect these changes.
+
+    Args:
+        clip: the clip
+        start: the first frame
+        end: the last frame
+        use_camera: whether the camera is used for rendering. Defaults to False.
+        layer_selection: the rendered layers, if None the visible ones. Defaults to None.
+
+    Returns:
+        the hash of the inputs of each frame
+    """
+    clip.make_current()
+    with snapshot_cache.freeze():
+        layers = clip.layers_snapshot()
+        if layer_selection is not None:
+            selected_ids = {layer.id for layer in layer_selection}
+            layers = [layer for layer in layers if layer.id in selected_ids]
+        else:
+            layers = [layer for layer in layers if layer.data.visibility]
+
+        layers_inputs = [_layer_frame_inputs(layer, start, end) for layer in layers]
+
+    camera: Any = None
+    if use_camera:
+        camera_info = dataclasses.asdict(george.tv_camera_info_get())
+        points = george.tv_camera_enum_points_all()
+        camera = [camera_info, [dataclasses.asdict(point) for point in points]]
+
+    return {
+        frame: _digest([camera, [inputs[frame] for inputs in layers_inputs]])
+        for frame in range(start, end + 1)
+    }
+
+
+def render_incremental(
+    clip: Clip,
+    output_path: Path | str | FileSequence,
+    start: int | None = None,
+    end: int | None = None,
+    use_camera: bool = False,
+    layer_selection: list[Layer] | None = None,
+    alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+    background_mode: george.BackgroundMode | None = None,
+    format_opts: list[str] | None = None,
+    force: bool = False,
+) -> list[int]:
+    """Render an image sequence of a clip, only the frames whose inputs changed since the last render.
+
+    The inputs of each frame (see `frame_signatures`) are stored in a manifest next to the images
+    (see `RenderManifest.path_for`). The frames missing on disk are always rendered.
+
+    Args:
+        clip: the clip to render
+        output_path: the image sequence pattern
+        start: the start frame to render or the mark in or the clip's start if None. Defaults to None.
+        end: the end frame to render or the mark out or the clip's end if None. Defaults to None.
+        use_camera: use the camera for rendering, otherwise render the whole canvas. Defaults to False.
+        layer_selection: list of layers to render, if None render all of them. Defaults to None.
+        alpha_mode: the alpha mode for rendering. Defaults to george.AlphaSaveMode.PREMULTIPLY.
+        background_mode: the background mode for rendering. Defaults to None.
+        format_opts: custom format options. Defaults to None.
+        force: render all the frames and rebuild the manifest. Defaults to False.
+
+    Raises:
+        ValueError: if the output is a movie
+        FileNotFoundError: if the render failed and no files were found on disk or missing frames
+
+    Returns:
+        the rendered frames
+    """
+    default_start = clip.mark_in or clip.start
+    default_end = clip.mark_out or clip.end
+    file_sequence, start, end, _, is_image = handle_output_range(
+        output_path, default_start, default_end, start, end
+    )
+    if not is_image:
+        raise ValueError(
+            f"Incremental renders only support images, got {file_sequence.extension()}"
+        )
+
+    settings = _digest(
+        [
+            file_sequence.extension().lower(),
+            alpha_mode,
+            background_mode,
+            format_opts,
+            use_camera,
+            [clip.project.width, clip.project.height],
+        ]
+    )
+    signatures = frame_signatures(clip, start, end, use_camera, layer_selection)
+
+    manifest = RenderManifest.load(RenderManifest.path_for(file_sequence))
+    if force or manifest.settings != settings:
+        manifest = RenderManifest(manifest.path, settings)
+    frames = manifest.outdated_frames(settings, signatures, file_sequence)
+
+    for run_start, run_end in frame_runs(frames):
+        chunk = file_sequence.copy()
+        chunk.setFrameSet(FrameSet(f"{run_start}-{run_end}"))
+        clip.render(
+            chunk,
+            run_start,
+            run_end,
+            use_camera,
+            layer_selection=layer_selection,
+            alpha_mode=alpha_mode,
+            background_mode=background_mode,
+            format_opts=format_opts,
+        )
+        for frame in range(run_start, run_end + 1):
+            manifest.frames[frame] = signatures[frame]
+        manifest.save()
+
+    log.info(f"Rendered {len(frames)} of {len(signatures)} frames to {file_sequence}")
+    return frames
+
+
+class StructureFormat(Enum):
+    """The clip structure export formats of `export_structures`.
+
+    Attributes:
+        JSON: the layer images and a JSON file describing them, see `Clip.export_json`
+        PSD: a PSD file with a layer per TVPaint layer, see `Clip.export_psd`
+        CSV: the layer images and a CSV file describing them, see `Clip.export_csv`
+        SPRITES: all the images in a sprite sheet, see `Clip.export_sprites`
+        FLIX: a Flix XML file and its images, see `Clip.export_flix` (it saves the project)
+    """
+
+    JSON = "json"
+    PSD = "psd"
+    CSV = "csv"
+    SPRITES = "sprites"
+    FLIX = "flix"
+
+
+@dataclass(frozen=True)
+class StructureExport:
+    """The verified output of a clip structure export.
+
+    Attributes:
+        clip_name: the name of the exported clip
+        format: the export format
+        path: the path of the main exported file
+        files: all the files of the export, in the export folder
+    """
+
+    clip_name: str
+    format: StructureFormat
+    path: Path
+    files: list[Path]
+
+
+def structure_path(
+    output_dir: Path | str,
+    clip_name: str,
+    structure_format: StructureFormat,
+    save_format: george.SaveFormat = george.SaveFormat.PNG,
+) -> Path:
+    """The path of a clip structure export, each clip and format has its own folder.
+
+    For example `out/clip_1/json/clip_1.json` or `out/clip_1/sprites/clip_1.png`.
+    """
+    if structure_format == StructureFormat.SPRITES:
+        extension = save_format.name.lower()
+    elif structure_format == StructureFormat.FLIX:
+        extension = "xml"
+    else:
+        extension = structure_format.value
+
+    folder = Path(output_dir, clip_name, structure_format.value)
+    return folder / f"{clip_name}.{extension}"
+
+
+def export_structure(
+    clip: Clip,
+    structure_format: StructureFormat,
+    export_path: Path,
+    save_format: george.SaveFormat = george.SaveFormat.PNG,
+) -> None:
+    """Export the structure of a clip in a format, with the default options of the `Clip.export_*` methods.
+
+    Raises:
+        FileNotFoundError: if the export failed and no files were found on disk
+    """
+    export_path.parent.mkdir(exist_ok=True, parents=True)
+
+    if structure_format == StructureFormat.JSON:
+        clip.export_json(export_path, save_format)
+    elif structure_format == StructureFormat.PSD:
+        clip.export_psd(export_path, george.PSDSaveMode.ALL)
+    elif structure_format == StructureFormat.CSV:
+        clip.export_csv(export_path, save_format)
+    elif structure_format == StructureFormat.SPRITES:
+        clip.export_sprites(export_path)
+    else:
+        clip.export_flix(export_path)
+
+
+def verify_structure(
+    clip_name: str,
+    structure_format: StructureFormat,
+    export_path: Path,
+) -> StructureExport:
+    """Check that the files of a clip structure export are complete and readable.
+
+    The JSON and CSV files are parsed and the files they describe are counted in the export folder.
+
+    Raises:
+        FileNotFoundError: if the exported file or its images are missing
+        ValueError: if the JSON or CSV file can't be parsed
+
+    Returns:
+        the verified export
+    """
+    if not export_path.is_file() or not export_path.stat().st_size:
+        raise FileNotFoundError(f"Could not find output at : {export_path.as_posix()}")
+
+    if structure_format == StructureFormat.JSON:
+        try:
+            json.loads(export_path.read_text(encoding="utf-8"))
+        except ValueError as e:
+            raise ValueError(f"Invalid JSON structure {export_path.as_posix()}: {e}")
+    elif structure_format == StructureFormat.CSV:
+        with export_path.open(newline="", encoding="utf-8") as csv_file:
+            if not any(csv.reader(csv_file)):
+                raise ValueError(f"Empty CSV structure {export_path.as_posix()}")
+
+    files = sorted(path for path in export_path.parent.rglob("*") if path.is_file())
+    images = [path for path in files if path != export_path]
+    if structure_format in (StructureFormat.JSON, StructureFormat.CSV) and not images:
+        raise FileNotFoundError(
+            f"No images were exported with {export_path.as_posix()}"
+        )
+
+    return StructureExport(clip_name, structure_format, export_path, files)
+
+
+def export_structures(
+    clips: Iterable[Clip],
+    output_dir: Path | str,
+    formats: Iterable[StructureFormat],
+    save_format: george.SaveFormat = george.SaveFormat.PNG,
+    max_workers: int = 4,
+) -> list[StructureExport]:
+    """Export the structure of several clips in several formats, see `structure_path` for the output paths.
+
+    The exports share a single render session, so the render settings are changed and restored once.
+    The outputs are verified on a thread pool while TVPaint exports the next ones, see `verify_structure`.
+
+    Args:
+        clips: the clips to export
+        output_dir: the output folder
+        formats: the export formats
+        save_format: the image format of the exports. Defaults to george.SaveFormat.PNG.
+        max_workers: the number of threads verifying the outputs. Defaults to 4.
+
+    Raises:
+        FileNotFoundError: if an export failed or is incomplete
+        ValueError: if an exported JSON or CSV file can't be parsed
+
+    Returns:
+        the verified exports, in the order of the clips then the formats
+    """
+    formats = list(formats)
+    with ThreadPoolExecutor(max_workers) as executor, render_session():
+        futures: list[Future[StructureExport]] = []
+        for clip in clips:
+            for structure_format in formats:
+                path = structure_path(
+                    output_dir, clip.name, structure_format, save_format
+                )
+                export_structure(clip, structure_format, path, save_format)
+                futures.append(
+                    executor.submit(verify_structure, clip.name, structure_format, path)
+                )
+        return [future.result() for future in futures]
+
+
+class RenderDispatcher:
+    """Render clips on several TVPaint instances at the same time.
+
+    The dispatcher holds a pool of clients, each one connected to a TVPaint instance (usually
+    headless ones running on different ports). Each instance loads the project from disk and
+    renders a chunk of the frames or a whole clip.
+
+    Example:
+        ```python
+        with RenderDispatcher.from_ports([3000, 3001, 3002]) as dispatcher:
+            dispatcher.render_clip("shot.tvpp", "clip_1", "out/clip_1.#.png")
+        ```
+
+    Note:
+        All the instances must have access to the project file and to the output folder.
+        Since the clips are found by name, make sure they have a unique name in the project.
+    """
+
+    def __init__(self, clients: Sequence[JSONRPCClient]) -> None:
+        """Initialize the dispatcher with connected clients.
+
+        Raises:
+            ValueError: if no client is given
+        """
+        if not clients:
+            raise ValueError("At least one client must be provided")
+
+        self.clients = list(clients)
+        self._available: queue.Queue[JSONRPCClient] = queue.Queue()
+        for client in self.clients:
+            self._available.put(client)
+
+    @classmethod
+    def from_ports(
+        cls,
+        ports: Iterable[int],
+        host: str = "ws://localhost",
+        timeout: int = 60,
+    ) -> RenderDispatcher:
+        """Connect to the TVPaint instances listening on the given ports.
+
+        Args:
+            ports: the ports of the TVPaint instances
+            host: the WebSocket host. Defaults to "ws://localhost".
+            timeout: the time in seconds to wait for each connection. Defaults to 60.
+
+        Returns:
+            the dispatcher
+        """
+        return cls([create_client(host, port, timeout) for port in ports])
+
+    def __enter__(self) -> RenderDispatcher:
+        """Returns the dispatcher, the clients are disconnected when exiting."""
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: TracebackType | None,
+    ) -> None:
+        """Disconnects all the clients."""
+        self.close()
+
+    def close(self) -> None:
+        """Disconnects all the clients."""
+        for client in self.clients:
+            if client.is_connected:
+                client.disconnect()
+
+    @contextlib.contextmanager
+    def _acquire_client(self) -> Iterator[JSONRPCClient]:
+        """Wait for an available client and send the George commands of the context to it."""
+        client = self._available.get()
+        try:
+            with use_client(client):
+                yield client
+        finally:
+            self._available.put(client)
+
+    @staticmethod
+    def _load_clip(project_path: Path, clip_name: str) -> Clip:
+        """Load the project in the current instance and get the clip by name.
+
+        Raises:
+            ValueError: if the clip was not found in the project
+        """
+        project = Project.load(project_path)
+        clip = project.get_clip(by_name=clip_name)
+        if not clip:
+            raise ValueError(f"Can't find clip {clip_name} in {project_path}")
+        return clip
+
+    def _render_task(
+        self,
+        project_path: Path,
+        clip_name: str,
+        output_path: Path | str | FileSequence,
+        start: int | None,
+        end: int | None,
+        render_options: dict[str, Any],
+    ) -> None:
+        with self._acquire_client() as client:
+            log.info(f"Rendering {clip_name} to {output_path} on {client.url}")
+            clip = self._load_clip(project_path, clip_name)
+            clip.render(output_path, start, end, **render_options)
+
+    @staticmethod
+    def _wait(futures: Sequence[Future[Any]]) -> None:
+        """Wait for all the tasks and raise the first error."""
+        errors = [future.exception() for future in futures]
+        first_error = next((error for error in errors if error), None)
+        if first_error:
+            raise first_error
+
+    def render_clip(
+        self,
+        project_path: Path | str,
+        clip_name: str,
+        output_path: Path | str | FileSequence,
+        start: int | None = None,
+        end: int | None = None,
+        chunk_size: int | None = None,
+        use_camera: bool = False,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = None,
+        format_opts: list[str] | None = None,
+    ) -> FileSequence:
+        """Render a clip, image sequences are split in chunks of frames rendered in parallel.
+
+        Movies and single images can't be split, they are rendered by one instance.
+        The range options are the same as `Clip.render`.
+
+        Args:
+            project_path: the path of the project file
+            clip_name: the name of the clip to render
+            output_path: a single file or file sequence pattern
+            start: the start frame to render or the mark in or the clip's start if None. Defaults to None.
+            end: the end frame to render or the mark out or the clip's end if None. Defaults to None.
+            chunk_size: the number of frames rendered by each task, if None the frames are split
+                evenly across the instances. Defaults to None.
+            use_camera: use the camera for rendering, otherwise render the whole canvas. Defaults to False.
+            alpha_mode: the alpha mode for rendering. Defaults to george.AlphaSaveMode.PREMULTIPLY.
+            background_mode: the background mode for rendering. Defaults to None.
+            format_opts: custom format options. Defaults to None.
+
+        Raises:
+            FileNotFoundError: if the render failed and no files were found on disk or missing frames
+
+        Returns:
+            the rendered file sequence
+        """
+        project_path = Path(project_path)
+        render_options: dict[str, Any] = {
+            "use_camera": use_camera,
+            "alpha_mode": alpha_mode,
+            "background_mode": background_mode,
+            "format_opts": format_opts,
+        }
+
+        with self._acquire_client():
+            clip = self._load_clip(project_path, clip_name)
+            default_start = clip.mark_in or clip.start
+            default_end = clip.mark_out or clip.end
+
+        file_sequence, start, end, is_sequence, _ = handle_output_range(
+            output_path, default_start, default_end, start, end
+        )
+
+        if is_sequence:
+            frame_count = end - start + 1
+            chunk_size = chunk_size or math.ceil(frame_count / len(self.clients))
+            tasks = [
+                (chunk, chunk.start(), chunk.end())
+                for chunk in split_file_sequence(file_sequence, chunk_size)
+            ]
+        else:
+            tasks = [(output_path, start, end)]
+
+        with ThreadPoolExecutor(max_workers=len(self.clients)) as executor:
+            futures = [
+                executor.submit(
+                    self._render_task,
+                    project_path,
+                    clip_name,
+                    task_output,
+                    task_start,
+                    task_end,
+                    render_options,
+                )
+                for task_output, task_start, task_end in tasks
+            ]
+            self._wait(futures)
+
+        if is_sequence:
+            check_sequence_on_disk(file_sequence)
+
+        return file_sequence
+
+    def render_clips(
+        self,
+        project_path: Path | str,
+        outputs: Mapping[str, Path | str | FileSequence],
+        use_camera: bool = False,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = None,
+        format_opts: list[str] | None = None,
+    ) -> None:
+        """Render several clips of a project, each clip is rendered by an available instance.
+
+        Args:
+            project_path: the path of the project file
+            outputs: the output path of each clip, by clip name
+            use_camera: use the camera for rendering, otherwise render the whole canvas. Defaults to False.
+            alpha_mode: the alpha mode for rendering. Defaults to george.AlphaSaveMode.PREMULTIPLY.
+            background_mode: the background mode for rendering. Defaults to None.
+            format_opts: custom format options. Defaults to None.
+
+        Raises:
+            FileNotFoundError: if the render failed and no files were found on disk or missing frames
+        """
+        project_path = Path(project_path)
+        render_options: dict[str, Any] = {
+            "use_camera": use_camera,
+            "alpha_mode": alpha_mode,
+            "background_mode": background_mode,
+            "format_opts": format_opts,
+        }
+
+        with ThreadPoolExecutor(max_workers=len(self.clients)) as executor:
+            futures = [
+                executor.submit(
+                    self._render_task,
+                    project_path,
+                    clip_name,
+                    clip_output,
+                    None,
+                    None,
+                    render_options,
+                )
+                for clip_name, clip_output in outputs.items()
+            ]
+            self._wait(futures)
+
+    def _export_structures_task(
+        self,
+        project_path: Path,
+        clip_name: str,
+        output_dir: Path | str,
+        formats: list[StructureFormat],
+        save_format: george.SaveFormat,
+        verify_executor: ThreadPoolExecutor,
+    ) -> list[Future[StructureExport]]:
+        with self._acquire_client() as client, render_session():
+            log.info(f"Exporting the structures of {clip_name} on {client.url}")
+            clip = self._load_clip(project_path, clip_name)
+
+            futures: list[Future[StructureExport]] = []
+            for structure_format in formats:
+                path = structure_path(
+                    output_dir, clip_name, structure_format, save_format
+                )
+                export_structure(clip, structure_format, path, save_format)
+                futures.append(
+                    verify_executor.submit(
+                        verify_structure, clip_name, structure_format, path
+                    )
+                )
+            return futures
+
+    def export_structures(
+        self,
+        project_path: Path | str,
+        output_dir: Path | str,
+        formats: Iterable[StructureFormat],
+        clip_names: Iterable[str] | None = None,
+        save_format: george.SaveFormat = george.SaveFormat.PNG,
+    ) -> list[StructureExport]:
+        """Export the structure of the clips of a project, each clip is exported by an available instance.
+
+        Like `export_structures`, the exports of a clip share a render session and the outputs are verified on a
+        thread pool while the instances keep exporting.
+
+        Args:
+            project_path: the path of the project file
+            output_dir: the output folder, see `structure_path` for the output paths
+            formats: the export formats
+            clip_names: the names of the clips to export, all the clips of the project if None. Defaults to None.
+            save_format: the image format of the exports. Defaults to george.SaveFormat.PNG.
+
+        Raises:
+            FileNotFoundError: if an export failed or is incomplete
+            ValueError: if an exported JSON or CSV file can't be parsed
+
+        Returns:
+            the verified exports, in the order of the clips then the formats
+        """
+        project_path = Path(project_path)
+        formats = list(formats)
+
+        if clip_names is None:
+            with self._acquire_client():
+                clip_names = [clip.name for clip in Project.load(project_path).clips]
+
+        with ThreadPoolExecutor() as verify_executor, ThreadPoolExecutor(
+            max_workers=len(self.clients)
+        ) as executor:
+            tasks = [
+                executor.submit(
+                    self._export_structures_task,
+                    project_path,
+                    clip_name,
+                    output_dir,
+                    formats,
+                    save_format,
+                    verify_executor,
+                )
+                for clip_name in clip_names
+            ]
+            self._wait(tasks)
+            return [future.result() for task in tasks for future in task.result()]
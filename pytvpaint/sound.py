@@ -9,7 +9,9 @@ from typing import TYPE_CHECKING, Any, Generic, TypeVar
 
 from typing_extensions import Self
 
-from pytvpaint import george, utils
+from pytvpaint import george
+from pytvpaint.george.client.cache import snapshot_cache
+from pytvpaint.george.exceptions import GeorgeError
 from pytvpaint.utils import (
     CanMakeCurrent,
     Removable,
@@ -25,16 +27,23 @@ P = TypeVar("P", bound=CanMakeCurrent)
 
 
 class BaseSound(Removable, ABC, Generic[P]):
-    """Base sound class for project and clip sounds."""
+    """Base sound class for project and clip sounds.
+
+    The info of all the tracks of the parent is fetched in a single George call and stored in the
+    snapshot cache, use `pytvpaint.cached` to read many sound properties with a single call.
+    """
 
     def __init__(
         self,
         track_index: int,
         parent: P,
+        data: george.TVPSound | None = None,
     ) -> None:
         super().__init__()
         self._parent = parent
-        self._data: george.TVPSound = self._info(self._parent.id, track_index)
+        self._data: george.TVPSound = data or self._cached_info(
+            self._parent.id, track_index
+        )
 
     @staticmethod
     @abstractmethod
@@ -44,13 +53,13 @@ class BaseSound(Removable, ABC, Generic[P]):
 
     @staticmethod
     @abstractmethod
-    def _info(parent_id: str | int, track_index: int) -> george.TVPSound:
-        """Get the sound data based on the track index."""
+    def _info_all(parent_id: str | int) -> list[george.TVPSound]:
+        """Get the data of all the sounds of the parent."""
         raise NotImplementedError()
 
     @abstractmethod
-    def _adjust(self, **kwargs: Any) -> None:
-        """Modify the sound data."""
+    def _adjust(self, info: george.TVPSound, **kwargs: Any) -> None:
+        """Modify the sound data, the values that are not provided are taken from `info`."""
         raise NotImplementedError()
 
     @abstractmethod
@@ -66,9 +75,24 @@ class BaseSound(Removable, ABC, Generic[P]):
     @classmethod
     def iter_sounds_data(cls, parent_id: str | int) -> Iterator[george.TVPSound]:
         """Iterator over the sound's data."""
-        return utils.position_generator(
-            lambda track_index: cls._info(parent_id, track_index)
-        )
+        return iter(cls._cached_info_all(parent_id))
+
+    @classmethod
+    def _cached_info_all(cls, parent_id: str | int) -> list[george.TVPSound]:
+        """Get the data of all the sounds of the parent through the snapshot cache."""
+        return snapshot_cache.get((cls.__name__, parent_id), cls._info_all, parent_id)
+
+    @classmethod
+    def _cached_info(cls, parent_id: str | int, track_index: int) -> george.TVPSound:
+        """Get the sound data through the snapshot cache.
+
+        Raises:
+            GeorgeError: if there's no sound at that track index
+        """
+        sounds_data = cls._cached_info_all(parent_id)
+        if not 0 <= track_index < len(sounds_data):
+            raise GeorgeError(f"No sound at track index {track_index}")
+        return sounds_data[track_index]
 
     def make_current(self) -> None:
         """Make the parent object current (there's no way to make a sound current)."""
@@ -79,15 +103,18 @@ class BaseSound(Removable, ABC, Generic[P]):
         """Create a new sound from the sound path."""
         parent.make_current()
         cls._new(Path(sound_path))
-        last_index = len(list(cls.iter_sounds_data(parent.id))) - 1
+        last_index = len(cls._cached_info_all(parent.id)) - 1
         return cls(last_index, parent)
 
     def refresh(self) -> None:
-        """Refreshes the sound data."""
+        """Refreshes the sound data.
+
+        The track index and the data are found in the same info of all the tracks, so that reading
+        a property outside of `pytvpaint.cached` fetches it only once.
+        """
         super().refresh()
-        if not self.refresh_on_call and self._data:
-            return
-        self._data = self._info(self.parent.id, self.track_index)
+        sounds_data = self._cached_info_all(self._parent.id)
+        self._data = sounds_data[self._find_track_index(sounds_data)]
 
     @property
     def track_index(self) -> int:
@@ -98,11 +125,65 @@ class BaseSound(Removable, ABC, Generic[P]):
         """
         # Recomputes the track_index each time because some track
         # can be deleted in the meantime
-        for index, data in enumerate(self.iter_sounds_data(self._parent.id)):
+        return self._find_track_index(self._cached_info_all(self._parent.id))
+
+    def _find_track_index(self, sounds_data: list[george.TVPSound]) -> int:
+        """Find the index of the sound in the data of all the sounds of the parent.
+
+        Raises:
+            ValueError: if sound object no longer exists
+        """
+        for index, data in enumerate(sounds_data):
             if data == self._data:
                 return index
         raise ValueError("The sound doesn't exist anymore")
 
+    @set_as_current
+    def adjust(
+        self,
+        mute: bool | None = None,
+        volume: float | None = None,
+        offset: float | None = None,
+        fade_in_start: float | None = None,
+        fade_in_stop: float | None = None,
+        fade_out_start: float | None = None,
+        fade_out_stop: float | None = None,
+        color_index: int | None = None,
+    ) -> None:
+        """Change several settings of the sound in a single George call, the settings that are None are unchanged.
+
+        Example:
+            ```python
+            sound.adjust(offset=2.5, fade_in_start=0, fade_in_stop=0.5)
+            ```
+
+        Args:
+            mute: mute or unmute the sound
+            volume: the volume of the sound
+            offset: the sound offset in the timeline
+            fade_in_start: the fade in start time
+            fade_in_stop: the fade in stop time
+            fade_out_start: the fade out start time
+            fade_out_stop: the fade out stop time
+            color_index: the sound color index
+        """
+        with snapshot_cache.freeze():
+            self.refresh()
+            track_index = self.track_index
+
+        self._adjust(
+            self._data,
+            track_index=track_index,
+            mute=mute,
+            volume=volume,
+            offset=offset,
+            fade_in_start=fade_in_start,
+            fade_in_stop=fade_in_stop,
+            fade_out_start=fade_out_start,
+            fade_out_stop=fade_out_stop,
+            color_index=color_index,
+        )
+
     @refreshed_property
     def offset(self) -> float:
         """The sound offset in the timeline."""
@@ -110,7 +191,7 @@ class BaseSound(Removable, ABC, Generic[P]):
 
     @offset.setter
     def offset(self, value: float) -> None:
-        self._adjust(offset=value)
+        self.adjust(offset=value)
 
     @refreshed_property
     def volume(self) -> float:
@@ -118,9 +199,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.volume
 
     @volume.setter
-    @set_as_current
     def volume(self, value: float) -> None:
-        self._adjust(volume=value)
+        self.adjust(volume=value)
 
     @refreshed_property
     def is_muted(self) -> bool:
@@ -128,9 +208,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.mute
 
     @is_muted.setter
-    @set_as_current
     def is_muted(self, value: bool) -> None:
-        self._adjust(mute=value)
+        self.adjust(mute=value)
 
     @refreshed_property
     def fade_in_start(self) -> float:
@@ -138,9 +217,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.fade_in_start
 
     @fade_in_start.setter
-    @set_as_current
     def fade_in_start(self, value: float) -> None:
-        self._adjust(fade_in_start=value)
+        self.adjust(fade_in_start=value)
 
     @refreshed_property
     def fade_in_stop(self) -> float:
@@ -148,9 +226,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.fade_in_stop
 
     @fade_in_stop.setter
-    @set_as_current
     def fade_in_stop(self, value: float) -> None:
-        self._adjust(fade_in_stop=value)
+        self.adjust(fade_in_stop=value)
 
     @refreshed_property
     def fade_out_start(self) -> float:
@@ -158,9 +235,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.fade_out_start
 
     @fade_out_start.setter
-    @set_as_current
     def fade_out_start(self, value: float) -> None:
-        self._adjust(fade_out_start=value)
+        self.adjust(fade_out_start=value)
 
     @refreshed_property
     def fade_out_stop(self) -> float:
@@ -168,9 +244,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.fade_out_stop
 
     @fade_out_stop.setter
-    @set_as_current
     def fade_out_stop(self, value: float) -> None:
-        self._adjust(fade_out_stop=value)
+        self.adjust(fade_out_stop=value)
 
     @refreshed_property
     def path(self) -> Path:
@@ -193,9 +268,8 @@ class BaseSound(Removable, ABC, Generic[P]):
         return self._data.color_index
 
     @color_index.setter
-    @set_as_current
     def color_index(self, value: int) -> None:
-        self._adjust(color_index=value)
+        self.adjust(color_index=value)
 
 
 class ClipSound(BaseSound["Clip"]):
@@ -205,11 +279,12 @@ class ClipSound(BaseSound["Clip"]):
         self,
         track_index: int,
         clip: Clip | None = None,
+        data: george.TVPSound | None = None,
     ) -> None:
         from pytvpaint.clip import Clip
 
         clip = clip or Clip.current_clip()
-        super().__init__(track_index, clip)
+        super().__init__(track_index, clip, data)
 
     def __eq__(self, other: object) -> bool:
         """Two clip sounds are equal if their track index is the same."""
@@ -218,12 +293,11 @@ class ClipSound(BaseSound["Clip"]):
         return self.track_index == other.track_index
 
     @staticmethod
-    def _info(parent_id: str | int, track_index: int) -> george.TVPSound:
-        return george.tv_sound_clip_info(int(parent_id), track_index)
+    def _info_all(parent_id: str | int) -> list[george.TVPSound]:
+        return george.tv_sound_clip_info_all(int(parent_id))
 
-    @set_as_current
-    def _adjust(self, **kwargs: Any) -> None:
-        return george.tv_sound_clip_adjust(self.track_index, **kwargs)
+    def _adjust(self, info: george.TVPSound, **kwargs: Any) -> None:
+        george.tv_sound_clip_adjust(info=info, **kwargs)
 
     @staticmethod
     def _new(sound_path: Path) -> None:
@@ -257,11 +331,12 @@ class ProjectSound(BaseSound["Project"]):
         self,
         track_index: int,
         project: Project | None = None,
+        data: george.TVPSound | None = None,
     ) -> None:
         from pytvpaint.project import Project
 
         project = project or Project.current_project()
-        super().__init__(track_index, project)
+        super().__init__(track_index, project, data)
 
     def __eq__(self, other: object) -> bool:
         """Two project sounds are equal if their track index is the same."""
@@ -274,12 +349,11 @@ class ProjectSound(BaseSound["Project"]):
         george.tv_sound_project_new(sound_path)
 
     @staticmethod
-    def _info(parent_id: str | int, track_index: int) -> george.TVPSound:
-        return george.tv_sound_project_info(str(parent_id), track_index)
+    def _info_all(parent_id: str | int) -> list[george.TVPSound]:
+        return george.tv_sound_project_info_all(str(parent_id))
 
-    @set_as_current
-    def _adjust(self, **kwargs: Any) -> None:
-        return george.tv_sound_project_adjust(self.track_index, **kwargs)
+    def _adjust(self, info: george.TVPSound, **kwargs: Any) -> None:
+        george.tv_sound_project_adjust(info=info, **kwargs)
 
     @property
     def project(self) -> Project:
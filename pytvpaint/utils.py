@@ -3,9 +3,12 @@
 from __future__ import annotations
 
 import contextlib
+import dataclasses
 import re
 from abc import ABC, abstractmethod
-from collections.abc import Generator, Iterable, Iterator
+from collections.abc import Generator, Iterable, Iterator, Mapping
+from contextvars import ContextVar
+from dataclasses import dataclass
 from pathlib import Path
 from typing import (
     TYPE_CHECKING,
@@ -19,8 +22,9 @@ from fileseq.filesequence import FileSequence
 from fileseq.frameset import FrameSet
 from typing_extensions import ParamSpec, Protocol
 
-from pytvpaint import george
+from pytvpaint import george, log
 from pytvpaint.george.exceptions import GeorgeError
+from pytvpaint.image import RGBAImage, frame_dir, read_tga
 
 if TYPE_CHECKING:
     from pytvpaint.layer import Layer
@@ -46,10 +50,10 @@ else:
 
 
 class Refreshable(ABC):
-    """Abstract class that denotes an object that have data that can be refreshed (a TVPaint project for example)."""
+    """Abstract class that denotes an object that have data that can be refreshed (a TVPaint project for example).
 
-    def __init__(self) -> None:
-        self.refresh_on_call = True
+    The data is read through the session snapshot cache (see `pytvpaint.cached`).
+    """
 
     @abstractmethod
     def refresh(self) -> None:
@@ -183,27 +187,70 @@ class Renderable(ABC):
 
         # make sure the output exists otherwise raise an error
         if is_sequence:
-            # raises error if sequence not found
-            found_sequence = FileSequence.findSequenceOnDisk(str(file_sequence))
-            frame_set = found_sequence.frameSet()
-            file_sequence_frame_set = file_sequence.frameSet()
-
-            if file_sequence_frame_set is None or frame_set is None:
-                raise Exception("Should have frame set")
-
-            if not frame_set.issuperset(file_sequence_frame_set):
-                # not all frames found
-                missing_frames = file_sequence_frame_set.difference(frame_set)
-                raise FileNotFoundError(
-                    f"Not all frames found, missing frames ({missing_frames}) "
-                    f"in sequence : {output_path}"
-                )
+            check_sequence_on_disk(file_sequence)
         else:
             if not first_frame.exists():
                 raise FileNotFoundError(
                     f"Could not find output at : {first_frame.as_posix()}"
                 )
 
+    def read_display(
+        self,
+        frame: int | None = None,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = None,
+    ) -> RGBAImage:
+        """Get the pixels of the display at the given frame.
+
+        Args:
+            frame: the frame to read or the current frame if None. Defaults to None.
+            alpha_mode: the render alpha mode. Defaults to george.AlphaSaveMode.PREMULTIPLY.
+            background_mode: the render background mode. Defaults to None.
+
+        Returns:
+            the RGBA image of the display
+        """
+        frame = frame if frame is not None else self.current_frame
+        with contextlib.closing(
+            self.read_displays(frame, frame, alpha_mode, background_mode)
+        ) as displays:
+            return next(displays)[1]
+
+    def read_displays(
+        self,
+        start: int,
+        end: int,
+        alpha_mode: george.AlphaSaveMode = george.AlphaSaveMode.PREMULTIPLY,
+        background_mode: george.BackgroundMode | None = None,
+    ) -> Iterator[tuple[int, RGBAImage]]:
+        """Iterate over the pixels of the display in a frame range, one frame at a time.
+
+        Each frame is saved as an uncompressed image in a temporary directory (see `pytvpaint.image.frame_dir`)
+        and removed as soon as it's read, the render settings are applied once for the whole range.
+
+        Args:
+            start: the first frame to read
+            end: the last frame to read
+            alpha_mode: the render alpha mode. Defaults to george.AlphaSaveMode.PREMULTIPLY.
+            background_mode: the render background mode. Defaults to None.
+
+        Yields:
+            the frame and the RGBA image of the display
+        """
+        self._validate_range(start, end)
+        save_format = george.SaveFormat.TGA
+
+        with frame_dir() as tmp_dir, render_context(
+            alpha_mode, background_mode, save_format
+        ), restore_current_frame(self, start):
+            for frame in range(start, end + 1):
+                self.current_frame = frame
+                image_path = tmp_dir / f"display.{frame}.tga"
+                george.tv_save_display(image_path)
+                image = read_tga(image_path)
+                image_path.unlink()
+                yield frame, image
+
 
 def get_unique_name(names: Iterable[str], stub: str) -> str:
     """Get a unique name from a list of names and a stub prefix. It does auto increment it.
@@ -293,6 +340,8 @@ def set_as_current(func: Callable[Params, ReturnType]) -> Callable[Params, Retur
 
     Sets the current TVPaint object as 'current'.
     Useful when George functions only apply on the current project, clip, layer or scene.
+    The current ids are tracked in the snapshot cache, so in a `cached` context it only sends
+    commands when the object isn't the current one.
 
     Args:
         func (Callable[Params, ReturnType]): the method apply on
@@ -309,6 +358,209 @@ def set_as_current(func: Callable[Params, ReturnType]) -> Callable[Params, Retur
     return wrapper
 
 
+@dataclass
+class RenderState:
+    """The render settings of TVPaint."""
+
+    alpha_mode: george.AlphaSaveMode
+    save_format: george.SaveFormat
+    save_args: list[str]
+    background_mode: george.BackgroundMode
+    background_colors: tuple[george.RGBColor, george.RGBColor] | george.RGBColor | None
+
+    @classmethod
+    def current(cls) -> RenderState:
+        """Read the current render settings in TVPaint."""
+        save_format, save_args = george.tv_save_mode_get()
+        background_mode, background_colors = george.tv_background_get()
+        return cls(
+            george.tv_alpha_save_mode_get(),
+            save_format,
+            save_args,
+            background_mode,
+            background_colors,
+        )
+
+
+def _set_layers_visibility(visibility: Mapping[int, bool]) -> None:
+    """Show and hide layers, with one bulk setter call for each state."""
+    for state in (True, False):
+        layer_ids = [layer for layer, shown in visibility.items() if shown == state]
+        if layer_ids:
+            george.tv_layers_set(layer_ids, visible=state)
+
+
+class RenderSession:
+    """Keeps track of the render state applied by `render_context` to skip the George calls that don't change anything.
+
+    The original render settings and layer visibilities are read when the session starts and restored once by
+    `restore`, so make sure the render settings are not modified by something else during the session.
+    """
+
+    def __init__(self) -> None:
+        """Start a session from the current render settings in TVPaint."""
+        self.original = RenderState.current()
+        self.applied = dataclasses.replace(self.original)
+        # The original visibility of the layers changed during the session, by clip id
+        self._original_visibility: dict[int, dict[int, bool]] = {}
+
+    def apply(
+        self,
+        alpha_mode: george.AlphaSaveMode | None = None,
+        background_mode: george.BackgroundMode | None = None,
+        save_format: george.SaveFormat | None = None,
+        format_opts: list[str] | None = None,
+        layer_selection: list[Layer] | None = None,
+    ) -> None:
+        """Apply the render settings that differ from the current ones, in a single batch request.
+
+        The layers of the current clip are shown if they are in the selection and hidden otherwise.
+        Without a selection, the layers changed by a previous render get their original visibility back.
+        """
+        visibility_changes = self._visibility_changes(layer_selection)
+
+        with george.batch():
+            if alpha_mode and alpha_mode != self.applied.alpha_mode:
+                george.tv_alpha_save_mode_set(alpha_mode)
+                self.applied.alpha_mode = alpha_mode
+
+            if background_mode and background_mode != self.applied.background_mode:
+                george.tv_background_set(background_mode)
+                self.applied.background_mode = background_mode
+                self.applied.background_colors = None
+
+            save_args = [str(opt) for opt in format_opts or []]
+            is_same_save_mode = (save_format, save_args) == (
+                self.applied.save_format,
+                self.applied.save_args,
+            )
+            if save_format and not is_same_save_mode:
+                george.tv_save_mode_set(save_format, *save_args)
+                self.applied.save_format = save_format
+                self.applied.save_args = save_args
+
+            _set_layers_visibility(visibility_changes)
+
+    def _visibility_changes(
+        self, layer_selection: list[Layer] | None
+    ) -> dict[int, bool]:
+        """Get the layers of the current clip whose visibility must change for the render."""
+        if not layer_selection and not self._original_visibility:
+            return {}
+
+        clip_id = george.tv_clip_current_id()
+        if not layer_selection and clip_id not in self._original_visibility:
+            return {}
+
+        selected_ids = {layer.id for layer in layer_selection or []}
+        original_visibility = self._original_visibility.setdefault(clip_id, {})
+        changes: dict[int, bool] = {}
+
+        for layer in george.tv_layer_info_all(clip_id):
+            if layer_selection:
+                should_be_visible = layer.id in selected_ids
+            else:
+                should_be_visible = original_visibility.get(layer.id, layer.visibility)
+
+            if layer.visibility == should_be_visible:
+                continue
+
+            changes[layer.id] = should_be_visible
+            original = original_visibility.setdefault(layer.id, layer.visibility)
+            if original == should_be_visible:
+                del original_visibility[layer.id]
+
+        if not original_visibility:
+            del self._original_visibility[clip_id]
+
+        return changes
+
+    def restore(self) -> None:
+        """Restore the original render settings and layer visibilities, in a single batch request.
+
+        The clips whose layers were changed are made current in turn, then the current clip is selected again.
+        """
+        original, applied = self.original, self.applied
+        visibility = self._original_visibility
+        current_clip = george.tv_clip_current_id() if visibility else None
+
+        try:
+            with george.batch():
+                if applied.alpha_mode != original.alpha_mode:
+                    george.tv_alpha_save_mode_set(original.alpha_mode)
+                if (applied.save_format, applied.save_args) != (
+                    original.save_format,
+                    original.save_args,
+                ):
+                    george.tv_save_mode_set(original.save_format, *original.save_args)
+                if (applied.background_mode, applied.background_colors) != (
+                    original.background_mode,
+                    original.background_colors,
+                ):
+                    george.tv_background_set(
+                        original.background_mode, original.background_colors
+                    )
+
+                other_clips = [
+                    clip_id for clip_id in visibility if clip_id != current_clip
+                ]
+                for clip_id in other_clips:
+                    george.tv_clip_select(clip_id)
+                    _set_layers_visibility(visibility[clip_id])
+                if current_clip is not None:
+                    if other_clips:
+                        george.tv_clip_select(current_clip)
+                    _set_layers_visibility(visibility.get(current_clip, {}))
+        finally:
+            # The session is back to its original state even if restoring failed
+            self.applied = dataclasses.replace(original)
+            self._original_visibility.clear()
+
+
+_render_session: ContextVar[RenderSession | None] = ContextVar(
+    "_render_session", default=None
+)
+
+
+@contextlib.contextmanager
+def render_session() -> Generator[RenderSession, None, None]:
+    """Context used to render many times in a row, the render settings are restored once when exiting.
+
+    Each `render_context` (and so each `Clip.render`, `Project.render`...) in the session only sends the George
+    commands that change a render setting or a layer visibility. Nested sessions are merged with the outer one.
+
+    Example:
+        ```python
+        with render_session():
+            for clip in project.clips:
+                clip.render(f"out/{clip.name}.#.png")
+        ```
+
+    Yields:
+        the render session
+    """
+    current_session = _render_session.get()
+    if current_session is not None:
+        yield current_session
+        return
+
+    session = RenderSession()
+    token = _render_session.set(session)
+    try:
+        yield session
+    except BaseException:
+        _render_session.reset(token)
+        # Don't hide the error of the session behind the one of the restore
+        try:
+            session.restore()
+        except Exception:
+            log.exception("Could not restore the render settings")
+        raise
+
+    _render_session.reset(token)
+    session.restore()
+
+
 @contextlib.contextmanager
 def render_context(
     alpha_mode: george.AlphaSaveMode | None = None,
@@ -325,6 +577,9 @@ def render_context(
     - Hide / Show the given layers (some render functions only render by visibility)
     - Restore the previous values after rendering
 
+    Only the settings and layers that differ from the current state are changed, in a single batch request.
+    In a `render_session`, the previous values are restored when exiting the session instead.
+
     Args:
         alpha_mode: the render alpha save mode
         save_format: the render format to use. Defaults to None.
@@ -332,45 +587,12 @@ def render_context(
         format_opts: the custom format options as strings. Defaults to None.
         layer_selection: the layers to render. Defaults to None.
     """
-    from pytvpaint.clip import Clip
-
-    # Save the current state
-    pre_alpha_save_mode = george.tv_alpha_save_mode_get()
-    pre_save_format, pre_save_args = george.tv_save_mode_get()
-    pre_background_mode, pre_background_colors = george.tv_background_get()
-
-    # Set the save mode values
-    if alpha_mode:
-        george.tv_alpha_save_mode_set(alpha_mode)
-    if background_mode:
-        george.tv_background_set(background_mode)
-    if save_format:
-        george.tv_save_mode_set(save_format, *(format_opts or []))
-
-    layers_visibility = []
-    if layer_selection:
-        clip = Clip.current_clip()
-        layers_visibility = [(layer, layer.is_visible) for layer in clip.layers]
-        # Show and hide the clip layers to render
-        for layer, _ in layers_visibility:
-            should_be_visible = not layer_selection or layer in layer_selection
-            layer.is_visible = should_be_visible
-
-    # Do the render
-    yield
-
-    # Restore the previous values
-    if alpha_mode:
-        george.tv_alpha_save_mode_set(pre_alpha_save_mode)
-    if save_format:
-        george.tv_save_mode_set(pre_save_format, *pre_save_args)
-    if background_mode:
-        george.tv_background_set(pre_background_mode, pre_background_colors)
-
-    # Restore the layer visibility
-    if layers_visibility:
-        for layer, was_visible in layers_visibility:
-            layer.is_visible = was_visible
+    with render_session() as session:
+        session.apply(
+            alpha_mode, background_mode, save_format, format_opts, layer_selection
+        )
+        # Do the render
+        yield
 
 
 class HasCurrentFrame(Protocol):
@@ -454,6 +676,29 @@ def get_tvp_element(
     return None
 
 
+def check_sequence_on_disk(file_sequence: FileSequence) -> None:
+    """Check that all the frames of a rendered file sequence exist on disk.
+
+    Raises:
+        FileNotFoundError: if the sequence was not found or some frames are missing
+    """
+    # raises error if sequence not found
+    found_sequence = FileSequence.findSequenceOnDisk(str(file_sequence))
+    frame_set = found_sequence.frameSet()
+    file_sequence_frame_set = file_sequence.frameSet()
+
+    if file_sequence_frame_set is None or frame_set is None:
+        raise Exception("Should have frame set")
+
+    if not frame_set.issuperset(file_sequence_frame_set):
+        # not all frames found
+        missing_frames = file_sequence_frame_set.difference(frame_set)
+        raise FileNotFoundError(
+            f"Not all frames found, missing frames ({missing_frames}) "
+            f"in sequence : {file_sequence}"
+        )
+
+
 def handle_output_range(
     output_path: Path | str | FileSequence,
     default_start: int,
@@ -0,0 +1,342 @@
+"""Change feed of the clip and layer structure of a project, to mirror it without walking the whole project each time."""
+
+from __future__ import annotations
+
+import threading
+from collections.abc import Iterator, Mapping
+from dataclasses import dataclass, field
+from enum import Enum
+
+from pytvpaint import george
+from pytvpaint.project import Project
+
+ProjectState = dict[int, "ClipState"]
+
+
+class ChangeKind(Enum):
+    """The kinds of structure changes reported by `ProjectWatcher`.
+
+    Attributes:
+        CLIP_ADDED:
+        CLIP_REMOVED:
+        CLIP_RENAMED:
+        LAYER_ADDED:
+        LAYER_REMOVED:
+        LAYER_RENAMED:
+        LAYER_CHANGED: any other layer info changed (position, visibility, frame range...)
+        INSTANCES_CHANGED: instances were added, removed or moved
+    """
+
+    CLIP_ADDED = "clip_added"
+    CLIP_REMOVED = "clip_removed"
+    CLIP_RENAMED = "clip_renamed"
+    LAYER_ADDED = "layer_added"
+    LAYER_REMOVED = "layer_removed"
+    LAYER_RENAMED = "layer_renamed"
+    LAYER_CHANGED = "layer_changed"
+    INSTANCES_CHANGED = "instances_changed"
+
+
+@dataclass(frozen=True)
+class LayerState:
+    """The state of a layer at a poll.
+
+    Attributes:
+        clip_id: the id of the layer's clip
+        info: the layer info
+        instance_starts: the start frames of the layer instances, empty if the watcher doesn't track them
+    """
+
+    clip_id: int
+    info: george.TVPLayer
+    instance_starts: tuple[int, ...] = ()
+
+    @property
+    def id(self) -> int:
+        """The layer id."""
+        return self.info.id
+
+
+@dataclass(frozen=True)
+class ClipState:
+    """The state of a clip at a poll.
+
+    Attributes:
+        name: the clip name
+        layers: the layer states by layer id, in position order
+    """
+
+    name: str
+    layers: dict[int, LayerState] = field(default_factory=dict)
+
+
+@dataclass(frozen=True)
+class ProjectChange:
+    """A change of the project structure between two polls.
+
+    Attributes:
+        kind: the kind of change
+        clip_id: the id of the changed clip, or of the changed layer's clip
+        before: the layer state at the previous poll, None for added layers and clip changes
+        after: the layer state at this poll, None for removed layers and clip changes
+        clip_name: the name of the clip at this poll, or at the previous poll if it was removed
+        previous_clip_name: the name of the clip at the previous poll, for `CLIP_RENAMED` changes
+    """
+
+    kind: ChangeKind
+    clip_id: int
+    before: LayerState | None = None
+    after: LayerState | None = None
+    clip_name: str = ""
+    previous_clip_name: str | None = None
+
+    @property
+    def layer_id(self) -> int | None:
+        """The id of the changed layer, None for clip changes."""
+        state = self.after or self.before
+        return state.id if state else None
+
+    @property
+    def added_starts(self) -> list[int]:
+        """The instance start frames that appeared since the previous poll."""
+        before = set(self.before.instance_starts if self.before else ())
+        after = self.after.instance_starts if self.after else ()
+        return [frame for frame in after if frame not in before]
+
+    @property
+    def removed_starts(self) -> list[int]:
+        """The instance start frames that disappeared since the previous poll."""
+        after = set(self.after.instance_starts if self.after else ())
+        before = self.before.instance_starts if self.before else ()
+        return [frame for frame in before if frame not in after]
+
+
+def diff_states(before: ProjectState, after: ProjectState) -> list[ProjectChange]:
+    """Get the changes between two project states, clips first then layers in their clip order.
+
+    Args:
+        before: the clip states by clip id at the previous poll
+        after: the clip states by clip id at this poll
+
+    Returns:
+        the changes
+    """
+    changes: list[ProjectChange] = []
+
+    for clip_id, clip in before.items():
+        if clip_id in after:
+            continue
+        changes.append(
+            ProjectChange(ChangeKind.CLIP_REMOVED, clip_id, clip_name=clip.name)
+        )
+        changes.extend(_diff_layers(clip_id, clip.name, clip.layers, {}))
+
+    for clip_id, clip in after.items():
+        old = before.get(clip_id)
+        if old is None:
+            changes.append(
+                ProjectChange(ChangeKind.CLIP_ADDED, clip_id, clip_name=clip.name)
+            )
+        elif old.name != clip.name:
+            changes.append(
+                ProjectChange(
+                    ChangeKind.CLIP_RENAMED,
+                    clip_id,
+                    clip_name=clip.name,
+                    previous_clip_name=old.name,
+                )
+            )
+        old_layers = old.layers if old else {}
+        changes.extend(_diff_layers(clip_id, clip.name, old_layers, clip.layers))
+
+    return changes
+
+
+def _diff_layers(
+    clip_id: int,
+    clip_name: str,
+    before: Mapping[int, LayerState],
+    after: Mapping[int, LayerState],
+) -> Iterator[ProjectChange]:
+    """Get the changes of the layers of a clip."""
+
+    def change(
+        kind: ChangeKind, old: LayerState | None, new: LayerState | None
+    ) -> ProjectChange:
+        return ProjectChange(kind, clip_id, old, new, clip_name=clip_name)
+
+    for layer_id, state in before.items():
+        if layer_id not in after:
+            yield change(ChangeKind.LAYER_REMOVED, state, None)
+
+    for layer_id, state in after.items():
+        old = before.get(layer_id)
+        if old is None:
+            yield change(ChangeKind.LAYER_ADDED, None, state)
+            continue
+
+        if old.info.name != state.info.name:
+            yield change(ChangeKind.LAYER_RENAMED, old, state)
+        # Selecting a layer is not a structure change
+        if _comparable_info(old.info) != _comparable_info(state.info):
+            yield change(ChangeKind.LAYER_CHANGED, old, state)
+        if old.instance_starts != state.instance_starts:
+            yield change(ChangeKind.INSTANCES_CHANGED, old, state)
+
+
+def _comparable_info(info: george.TVPLayer) -> tuple[object, ...]:
+    """The layer info values that make a LAYER_CHANGED change."""
+    return (
+        info.visibility,
+        info.position,
+        info.density,
+        info.type,
+        info.first_frame,
+        info.last_frame,
+        info.editable,
+        info.stencil_state,
+    )
+
+
+@dataclass
+class ProjectWatcher:
+    """Polls the clip and layer structure of a project and reports the changes since the previous poll.
+
+    Each poll gets the clip names and the info of all the layers of the project in a single George call,
+    instead of walking `Project.clips`, `Clip.layers` and `Layer.instances`. If they are tracked, the
+    instances of the layers that are new or whose info changed are enumerated in a second call, the
+    other layers keep the instances of the previous poll.
+
+    Note:
+        Polling drives TVPaint's UI: the project is made current and stays so, each clip is selected
+        while its layers are listed, and each enumerated layer is made current and goes from instance
+        head to instance head. The current clip, layer and frame are restored at the end of each call,
+        but the UI visibly switches during a poll and someone editing the project at the same time may
+        see the current clip, layer or frame change.
+
+    Example:
+        ```python
+        watcher = ProjectWatcher(Project.current_project())
+        for changes in watcher.watch(interval=5):
+            for change in changes:
+                print(change.kind, change.clip_id, change.layer_id)
+        ```
+
+    Attributes:
+        project: the watched project
+        instances: True to track the instance start frames. Defaults to True.
+        state: the clip states by clip id at the last poll, empty until the first poll
+    """
+
+    project: Project
+    instances: bool = True
+    state: ProjectState = field(default_factory=dict)
+    _start_frame: int | None = field(default=None, init=False, repr=False)
+    _fetched_start_frame: int | None = field(default=None, init=False, repr=False)
+
+    def fetch(self, full: bool = False) -> ProjectState:
+        """Get the current state of the project structure, without comparing it to the last poll.
+
+        The layers whose info didn't change since the last poll keep their instances, so an instance
+        change that leaves the layer info as is (like moving an instance inside the layer frame range) is
+        only found by a full fetch. A full fetch is made when the project start frame changed.
+
+        Args:
+            full: True to enumerate the instances of all the layers. Defaults to False.
+
+        Returns:
+            the clip states by clip id
+        """
+        self.project.make_current()
+        clips = george.tv_clip_layers_enum()
+        if not self.instances:
+            return {
+                clip.clip_id: ClipState(
+                    clip.clip_name,
+                    {
+                        layer.id: LayerState(clip.clip_id, layer)
+                        for layer in clip.layers
+                    },
+                )
+                for clip in clips
+            }
+
+        start_frame = george.tv_start_frame_get()
+        self._fetched_start_frame = start_frame
+        full = full or start_frame != self._start_frame
+        previous = {
+            layer_id: state
+            for clip in self.state.values()
+            for layer_id, state in clip.layers.items()
+        }
+
+        def changed(layer: george.TVPLayer) -> bool:
+            old = previous.get(layer.id)
+            return old is None or _comparable_info(old.info) != _comparable_info(layer)
+
+        clip_layers = [
+            (clip.clip_id, [layer for layer in clip.layers if full or changed(layer)])
+            for clip in clips
+        ]
+        clip_layers = [(clip_id, layers) for clip_id, layers in clip_layers if layers]
+        starts = (
+            george.tv_exposure_enum_starts_project(clip_layers) if clip_layers else {}
+        )
+
+        def instance_starts(layer_id: int) -> tuple[int, ...]:
+            if layer_id not in starts:
+                return previous[layer_id].instance_starts
+            return tuple(start + start_frame for start in starts[layer_id])
+
+        return {
+            clip.clip_id: ClipState(
+                clip.clip_name,
+                {
+                    layer.id: LayerState(clip.clip_id, layer, instance_starts(layer.id))
+                    for layer in clip.layers
+                },
+            )
+            for clip in clips
+        }
+
+    def poll(self, full: bool = False) -> list[ProjectChange]:
+        """Get the project structure changes since the last poll.
+
+        The first poll reports all the clips and layers as added.
+
+        Args:
+            full: True to enumerate the instances of all the layers, see `fetch`. Defaults to False.
+
+        Returns:
+            the changes, clips first then layers in their clip order
+        """
+        state = self.fetch(full)
+        changes = diff_states(self.state, state)
+        self.state = state
+        self._start_frame = self._fetched_start_frame
+        return changes
+
+    def watch(
+        self,
+        interval: float = 2,
+        stop: threading.Event | None = None,
+        full_every: int = 10,
+    ) -> Iterator[list[ProjectChange]]:
+        """Poll the project at a regular interval and yield the changes when there are some.
+
+        Args:
+            interval: the time in seconds between two polls. Defaults to 2.
+            stop: an event to stop watching from another thread, watches forever by default
+            full_every: make a full poll (see `fetch`) every `full_every` polls, 0 to never. Defaults to 10.
+
+        Yields:
+            the changes of each poll that found some
+        """
+        stop = stop or threading.Event()
+        polls = 0
+        while not stop.is_set():
+            changes = self.poll(full=full_every > 0 and polls % full_every == 0)
+            polls += 1
+            if changes:
+                yield changes
+            stop.wait(interval)
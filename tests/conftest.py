@@ -1,17 +1,19 @@
 from __future__ import annotations
 
+import importlib.util
 import struct
+import timeit
 import wave
 from collections.abc import Generator
 from pathlib import Path
 from random import randint
-from typing import TypeVar
+from typing import Any, Callable, Protocol, TypeVar
 
 import pytest
 
 from pytvpaint import george
 from pytvpaint.clip import Clip
-from pytvpaint.george.client import send_cmd
+from pytvpaint.george.client import create_client, send_cmd, use_client
 from pytvpaint.george.grg_base import tv_pen_brush_set
 from pytvpaint.george.grg_clip import (
     TVPClip,
@@ -49,11 +51,52 @@ from pytvpaint.layer import Layer
 from pytvpaint.project import Project
 from pytvpaint.scene import Scene
 from pytvpaint.sound import ClipSound, ProjectSound
+from tests.mock_server import MockTVPaint
 
 T = TypeVar("T")
 FixtureYield = Generator[T, None, None]
 
 
+class Benchmark(Protocol):
+    """The interface of the pytest-benchmark fixture used by the benchmarks."""
+
+    extra_info: dict[str, Any]
+
+    def __call__(self, func: Callable[..., T], *args: Any, **kwargs: Any) -> T: ...
+
+
+class TimeitBenchmark:
+    """Minimal replacement of the pytest-benchmark fixture, it times the function with timeit."""
+
+    def __init__(self) -> None:
+        self.extra_info: dict[str, Any] = {}
+
+    def __call__(self, func: Callable[..., T], *args: Any, **kwargs: Any) -> T:
+        timer = timeit.Timer(lambda: func(*args, **kwargs))
+        loops, _ = timer.autorange()
+        best = min(timer.repeat(repeat=3, number=loops)) / loops
+        print(f"{func.__name__}: {best * 1e6:.2f} us per call {self.extra_info}")
+        return func(*args, **kwargs)
+
+
+if importlib.util.find_spec("pytest_benchmark") is None:
+
+    @pytest.fixture
+    def benchmark() -> Benchmark:
+        """Times the benchmarks when pytest-benchmark is not installed, run them with `pytest -s`"""
+        return TimeitBenchmark()
+
+
+@pytest.fixture
+def mock_tvpaint() -> FixtureYield[MockTVPaint]:
+    """Mock TVPaint server, the George commands of the test are sent to it"""
+    with MockTVPaint() as server:
+        client = create_client("ws://127.0.0.1", server.port, timeout=5)
+        with use_client(client):
+            yield server
+        client.disconnect()
+
+
 @pytest.fixture(scope="function")
 def pen_brush_reset() -> FixtureYield[None]:
     """Resets the pen brush after the test"""
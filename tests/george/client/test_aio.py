@@ -0,0 +1,232 @@
+from __future__ import annotations
+
+import asyncio
+import json
+import struct
+from typing import cast
+
+import pytest
+
+from pytvpaint.george import aio
+from pytvpaint.george.client.aio import (
+    AsyncJSONRPCClient,
+    _mask,
+    async_send_cmd,
+    async_send_cmds,
+    create_async_client,
+    get_async_client,
+    use_async_client,
+)
+from pytvpaint.george.client.rpc import JSONRPCResponseError
+from pytvpaint.george.exceptions import GeorgeError, NoObjectWithIdError
+from tests.mock_server import MockTVPaint, respond_clip
+
+
+def test_async_client_execute_remote() -> None:
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            response = await client.execute_remote("execute_george", ["tv_Version"])
+            assert response["result"] == "11.5"
+
+            with pytest.raises(JSONRPCResponseError, match="Method not found"):
+                await client.execute_remote("unknown")
+
+            results = await client.execute_remote_batch(
+                [("execute_george", ["tv_Version"]), ("unknown", [])]
+            )
+            assert not isinstance(results[0], Exception)
+            assert results[0]["result"] == "11.5"
+            assert isinstance(results[1], JSONRPCResponseError)
+
+        assert not client.is_connected
+
+    with MockTVPaint({"tv_Version": "11.5"}) as server:
+        asyncio.run(run(server))
+        assert server.requests == 3
+
+
+def test_async_client_pipelines_requests() -> None:
+    async def run(server: MockTVPaint) -> list[str]:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            with use_async_client(client):
+                return await asyncio.gather(
+                    *(async_send_cmd("tv_LayerGetID", pos) for pos in range(5))
+                )
+
+    with MockTVPaint({"tv_LayerGetID": lambda args: f"id_{args[0]}"}) as server:
+        results = asyncio.run(run(server))
+
+    assert results == [f"id_{pos}" for pos in range(5)]
+
+
+def test_async_client_reconnects() -> None:
+    async def run(server: MockTVPaint) -> None:
+        client = AsyncJSONRPCClient(server.url, timeout=5)
+        await client.connect()
+        await client.disconnect()
+        response = await client.execute_remote("execute_george", ["tv_Version"])
+        assert response["result"] == "11.5"
+        await client.disconnect()
+
+    with MockTVPaint({"tv_Version": "11.5"}) as server:
+        asyncio.run(run(server))
+
+
+def test_async_client_timeout() -> None:
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=0.5) as client:
+            with pytest.raises(TimeoutError):
+                await client.execute_remote("execute_george", ["tv_Version"])
+            with pytest.raises(TimeoutError):
+                await client.execute_remote_batch([("execute_george", ["tv_Version"])])
+            assert client._pending == {}
+
+            # The late responses are skipped, the next request gets its own
+            server.latency = 0
+            await asyncio.sleep(1.2)
+            response = await client.execute_remote("execute_george", ["tv_Version"])
+            assert response["result"] == "11.5"
+
+    with MockTVPaint({"tv_Version": "11.5"}, latency=0.8) as server:
+        asyncio.run(run(server))
+
+
+def test_async_client_invalid_messages() -> None:
+    error = {"code": -32700, "message": "Parse error"}
+    error_message = json.dumps({"id": None, "jsonrpc": "2.0", "error": error})
+
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            # Invalid messages are skipped without stopping the reader
+            client._handle_message(b"not json")
+            client._handle_message(b"\xff")
+            response = await client.execute_remote("execute_george", ["tv_Version"])
+            assert response["result"] == "11.5"
+
+            # An error without id fails the pending requests
+            _, future = client._payload("execute_george", ["tv_Version"])
+            client._handle_message(error_message.encode())
+            with pytest.raises(JSONRPCResponseError, match="Parse error"):
+                await future
+            assert client.is_connected
+
+    with MockTVPaint({"tv_Version": "11.5"}) as server:
+        asyncio.run(run(server))
+
+
+class FrameWriter:
+    """Records the frames written by the client, in place of a `StreamWriter`."""
+
+    def __init__(self) -> None:
+        self.frames: list[tuple[int, bytes]] = []
+        self.drained = 0
+
+    def write(self, data: bytes) -> None:
+        # The client frames are short and masked
+        opcode, length, key = data[0] & 0x0F, data[1] & 0x7F, data[2:6]
+        self.frames.append((opcode, _mask(data[6 : 6 + length], key)))
+
+    async def drain(self) -> None:
+        self.drained += 1
+
+
+def server_frame(opcode: int, payload: bytes) -> bytes:
+    return bytes([0x80 | opcode, len(payload)]) + payload
+
+
+def test_async_client_answers_control_frames() -> None:
+    status = struct.pack("!H", 1000)
+
+    async def run() -> FrameWriter:
+        client = AsyncJSONRPCClient("ws://127.0.0.1:3000")
+        reader = asyncio.StreamReader()
+        reader.feed_data(
+            server_frame(0x9, b"ping")
+            + server_frame(0x1, b"{}")
+            + server_frame(0x8, status + b"bye")
+        )
+        writer = FrameWriter()
+        stream_writer = cast(asyncio.StreamWriter, writer)
+
+        assert await client._read_message(reader, stream_writer) == b"{}"
+        assert await client._read_message(reader, stream_writer) is None
+        return writer
+
+    writer = asyncio.run(run())
+    # The ping is answered with a pong and the close frame is echoed
+    assert writer.frames == [(0xA, b"ping"), (0x8, status)]
+    assert writer.drained == 2
+
+
+def test_create_async_client_refused() -> None:
+    with MockTVPaint() as server:
+        port = server.port
+
+    with pytest.raises(ConnectionRefusedError):
+        asyncio.run(create_async_client("ws://127.0.0.1", port, timeout=1))
+
+
+def test_get_async_client_without_client() -> None:
+    with pytest.raises(RuntimeError, match="No async client"):
+        get_async_client()
+
+
+def test_async_send_cmd_errors() -> None:
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            with use_async_client(client):
+                with pytest.raises(GeorgeError):
+                    await async_send_cmd("tv_LayerGetID", 10, error_values=["none"])
+                with pytest.raises(GeorgeError):
+                    await async_send_cmds(
+                        [("tv_LayerCurrentId",), ("tv_LayerGetID", 10)],
+                        error_values=["none"],
+                    )
+
+    with MockTVPaint({"tv_LayerGetID": "none", "tv_LayerCurrentId": "2"}) as server:
+        asyncio.run(run(server))
+        # All the commands of the batch are executed even if one of them fails
+        assert server.commands == [
+            "tv_LayerGetID 10",
+            "tv_LayerCurrentId",
+            "tv_LayerGetID 10",
+        ]
+
+
+def test_aio_george_commands() -> None:
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            with use_async_client(client):
+                assert await aio.tv_clip_current_id() == 1
+                layer_id = await aio.tv_layer_current_id()
+                assert layer_id == layer_ids[0]
+                assert await aio.tv_layer_get_id(1) == layer_ids[1]
+
+                layer = await aio.tv_layer_info(layer_id)
+                assert layer.id == layer_id
+                assert layer.name == "layer_0"
+
+                with pytest.raises(GeorgeError, match="No layer at provided position"):
+                    await aio.tv_layer_get_id(10)
+
+                await aio.tv_layer_display_set(layer_id, False)
+                await aio.tv_layer_image(5)
+
+    with MockTVPaint() as server:
+        layer_ids = respond_clip(server, layer_count=3)
+        asyncio.run(run(server))
+        assert server.commands[-2:] == [
+            f"tv_LayerDisplay {layer_ids[0]} 0",
+            "tv_LayerImage 5",
+        ]
+
+
+def test_aio_layer_info_invalid_id() -> None:
+    async def run(server: MockTVPaint) -> None:
+        async with AsyncJSONRPCClient(server.url, timeout=5) as client:
+            with use_async_client(client):
+                with pytest.raises(NoObjectWithIdError, match="Invalid layer id"):
+                    await aio.tv_layer_info(0)
+
+    with MockTVPaint({"tv_LayerInfo": ""}) as server:
+        asyncio.run(run(server))
@@ -0,0 +1,188 @@
+from __future__ import annotations
+
+import pytest
+
+from pytvpaint import george
+from pytvpaint.george.client import use_client
+from pytvpaint.george.client.cache import (
+    SnapshotCache,
+    changes_current,
+    current,
+    mutates,
+    sets_current,
+    snapshot_cache,
+)
+from pytvpaint.george.client.rpc import JSONRPCClient
+from tests.mock_server import MockTVPaint
+
+
+class Fetcher:
+    def __init__(self) -> None:
+        self.calls = 0
+
+    def __call__(self, value: int) -> int:
+        self.calls += 1
+        return value
+
+
+@pytest.fixture
+def cache() -> SnapshotCache:
+    return SnapshotCache()
+
+
+def test_cache_no_ttl_always_fetch(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    assert cache.get(("layer", 1), fetch, 5) == 5
+    assert cache.get(("layer", 1), fetch, 5) == 5
+    assert fetch.calls == 2
+
+
+def test_cache_frozen(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    with cache.freeze():
+        for _ in range(3):
+            assert cache.get(("layer", 1), fetch, 5) == 5
+        cache.get(("layer", 2), fetch, 6)
+    assert fetch.calls == 2
+
+
+def test_cache_ttl(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    cache.ttl = 60
+    cache.get(("clip", 1), fetch, 1)
+    cache.get(("clip", 1), fetch, 1)
+    assert fetch.calls == 1
+
+
+def test_cache_until_mutation(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    cache.get(("current", "clip"), fetch, 1, until_mutation=True)
+    cache.get(("current", "clip"), fetch, 1, until_mutation=True)
+    assert fetch.calls == 1
+
+    cache.invalidate()
+    cache.get(("current", "clip"), fetch, 1, until_mutation=True)
+    assert fetch.calls == 2
+
+
+def test_cache_invalidate(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    with cache.freeze():
+        cache.get(("layer", 1), fetch, 1)
+        cache.get(("layer", 2), fetch, 2)
+
+        cache.invalidate(("layer", 1))
+        cache.get(("layer", 1), fetch, 1)
+        cache.get(("layer", 2), fetch, 2)
+        assert fetch.calls == 3
+
+        generation = cache.generation
+        cache.invalidate()
+        assert cache.generation == generation + 1
+        cache.get(("layer", 2), fetch, 2)
+        assert fetch.calls == 4
+
+
+def test_cache_mutates_invalidate() -> None:
+    fetch = Fetcher()
+
+    @mutates
+    def rename() -> None:
+        pass
+
+    with snapshot_cache.freeze():
+        snapshot_cache.get(("layer", 1), fetch, 1)
+        rename()
+        snapshot_cache.get(("layer", 1), fetch, 1)
+
+    assert fetch.calls == 2
+
+
+def test_cache_mutates_invalidate_on_error() -> None:
+    @mutates
+    def fail() -> None:
+        raise ValueError()
+
+    generation = snapshot_cache.generation
+    with pytest.raises(ValueError):
+        fail()
+    assert snapshot_cache.generation == generation + 1
+
+
+def test_cache_scoped_by_client(cache: SnapshotCache) -> None:
+    fetch = Fetcher()
+    with cache.freeze():
+        assert cache.get(("layer", 1), fetch, 1) == 1
+        with use_client(JSONRPCClient("ws://localhost:3001")):
+            assert cache.get(("layer", 1), fetch, 2) == 2
+        assert cache.get(("layer", 1), fetch, 3) == 1
+    assert fetch.calls == 2
+
+
+def test_cache_current_tracking() -> None:
+    fetch = Fetcher()
+
+    @sets_current("clip")
+    @mutates
+    def select(clip_id: int) -> None:
+        pass
+
+    @changes_current("clip")
+    def move() -> None:
+        pass
+
+    with snapshot_cache.freeze():
+        assert current("clip", lambda: fetch(1)) == 1
+        assert current("clip", lambda: fetch(1)) == 1
+        assert fetch.calls == 1
+
+        select(2)
+        assert current("clip", lambda: fetch(1)) == 2
+        assert fetch.calls == 1
+
+        move()
+        assert current("clip", lambda: fetch(1)) == 1
+        assert fetch.calls == 2
+
+
+def test_cache_current_set_until_mutation() -> None:
+    fetch = Fetcher()
+
+    @sets_current("clip")
+    @changes_current("clip")
+    def select(clip_id: int) -> None:
+        pass
+
+    @mutates
+    def rename() -> None:
+        pass
+
+    # Without a cached context, the fetched values expire but the set ones are kept
+    assert current("clip", lambda: fetch(1)) == 1
+    assert current("clip", lambda: fetch(1)) == 1
+    assert fetch.calls == 2
+
+    select(2)
+    assert current("clip", lambda: fetch(1)) == 2
+    assert fetch.calls == 2
+
+    rename()
+    assert current("clip", lambda: fetch(1)) == 1
+    assert fetch.calls == 3
+
+
+def test_cache_selection_keeps_snapshot(mock_tvpaint: MockTVPaint) -> None:
+    fetch = Fetcher()
+
+    with snapshot_cache.freeze():
+        snapshot_cache.get(("layer", 1), fetch, 1)
+        george.tv_clip_select(2)
+        george.tv_layer_set(3)
+        snapshot_cache.get(("layer", 1), fetch, 1)
+        assert fetch.calls == 1
+        assert current("clip", lambda: fetch(1)) == 2
+        assert current("layer", lambda: fetch(1)) == 3
+
+        george.tv_layer_blending_mode_set(3, george.BlendingMode.ADD)
+        snapshot_cache.get(("layer", 1), fetch, 1)
+        assert fetch.calls == 2
@@ -0,0 +1,81 @@
+"""Benchmarks of the client stack against the mock TVPaint server, run them with `pytest -s` to see the timings."""
+
+from __future__ import annotations
+
+from concurrent.futures import wait
+
+from pytvpaint import george
+from pytvpaint.george.client import (
+    _check_result,
+    _format_cmd,
+    send_cmd,
+    send_cmd_future,
+)
+from pytvpaint.george.client.rpc import json_dumps, json_library, json_loads
+from pytvpaint.george.exceptions import GeorgeError
+from tests.conftest import Benchmark
+from tests.mock_server import MockTVPaint
+
+
+def test_benchmark_encode_cmd(benchmark: Benchmark) -> None:
+    # The client side of a command without the round trip to TVPaint
+    def encode_cmd() -> str:
+        cmd_str = _format_cmd("tv_LayerRename", (100, "a layer name"), True)
+        json_dumps({"jsonrpc": "2.0", "id": 1, "method": "run", "params": [cmd_str]})
+        response = json_loads('{"jsonrpc": "2.0", "id": 1, "result": "12"}')
+        return _check_result(response["result"], ["none", -1])
+
+    benchmark.extra_info["json"] = json_library
+    assert benchmark(encode_cmd) == "12"
+
+
+def test_benchmark_send_cmd(mock_tvpaint: MockTVPaint, benchmark: Benchmark) -> None:
+    mock_tvpaint.respond("tv_LayerCurrentId", "12")
+    assert benchmark(send_cmd, "tv_LayerCurrentId") == "12"
+
+
+def test_benchmark_send_cmd_error(
+    mock_tvpaint: MockTVPaint, benchmark: Benchmark
+) -> None:
+    mock_tvpaint.respond("tv_LayerGetID", "none")
+
+    def send_with_error() -> None:
+        try:
+            send_cmd("tv_LayerGetID", 1000, error_values=["none", -1])
+        except GeorgeError:
+            return
+        raise AssertionError("The error value was not detected")
+
+    benchmark(send_with_error)
+
+
+def test_benchmark_send_cmd_strings(
+    mock_tvpaint: MockTVPaint, benchmark: Benchmark
+) -> None:
+    benchmark(send_cmd, "tv_LayerRename", 100, "a layer name with spaces")
+    assert mock_tvpaint.commands[-1] == 'tv_LayerRename 100 "a layer name with spaces"'
+
+
+def test_benchmark_batch(mock_tvpaint: MockTVPaint, benchmark: Benchmark) -> None:
+    def send_batch() -> None:
+        with george.batch():
+            for layer_id in range(100):
+                george.tv_layer_display_set(layer_id, True)
+
+    mock_tvpaint.reset_stats()
+    send_batch()
+    benchmark.extra_info["rpc_count"] = mock_tvpaint.requests
+    assert mock_tvpaint.requests == 1
+
+    benchmark(send_batch)
+
+
+def test_benchmark_pipelined_latency(
+    mock_tvpaint: MockTVPaint, benchmark: Benchmark
+) -> None:
+    mock_tvpaint.latency = 0.001
+
+    def send_pipelined() -> None:
+        wait([send_cmd_future("tv_LayerInfo", layer_id) for layer_id in range(20)])
+
+    benchmark(send_pipelined)
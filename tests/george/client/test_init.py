@@ -1,13 +1,31 @@
 from __future__ import annotations
 
+import time
 from pathlib import Path
 from typing import NoReturn
 
 import pytest
 
-from pytvpaint.george.client import run_script, send_cmd, try_cmd
+from pytvpaint.george.client import (
+    GeorgeProgram,
+    batch,
+    connect,
+    create_client,
+    get_client,
+    get_default_client,
+    run_inline_script,
+    run_script,
+    send_cmd,
+    send_cmd_future,
+    send_cmds,
+    try_cmd,
+    use_client,
+)
+from pytvpaint.george.client.parse import tv_parse_list
+from pytvpaint.george.client.rpc import JSONRPCClient
 from pytvpaint.george.exceptions import GeorgeError
 from pytvpaint.george.grg_base import GrgErrorValue
+from tests.mock_server import MockTVPaint
 
 
 def test_decorate_try_cmd() -> None:
@@ -46,6 +64,98 @@ def test_run_grg_script(tmp_path: Path) -> None:
     assert tmp_img.exists()
 
 
+def test_run_inline_script() -> None:
+    lines = run_inline_script(
+        """
+tv_Version
+tv_WriteTextFile "append" pytvpaint_output result
+tv_WriteTextFile "append" pytvpaint_output "done"
+"""
+    )
+    assert lines == [send_cmd("tv_Version"), "done"]
+
+
+def test_george_program_source() -> None:
+    program = GeorgeProgram()
+    program.cmd("tv_LayerCreate", "my layer").assign("layer_id", "result")
+    with program.block("IF layer_id > 0"):
+        program.cmd("tv_LayerKill", GeorgeProgram.var("layer_id"))
+    program.write("layer_id")
+
+    assert program.source == "\n".join(
+        [
+            'tv_LayerCreate "my layer"',
+            "layer_id = result",
+            "IF layer_id > 0",
+            "    tv_LayerKill layer_id",
+            "END",
+            'tv_WriteTextFile "append" pytvpaint_output layer_id',
+        ]
+    )
+
+
+def test_george_program_run() -> None:
+    program = GeorgeProgram()
+    program.cmd("tv_Version").write("result").write('"done"')
+    assert program.run() == [send_cmd("tv_Version"), "done"]
+
+
+def test_george_program_check_source() -> None:
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", 12).check()
+    with program.checks():
+        program.cmd("tv_LayerPaste").check("paste")
+    program.cmd("tv_LayerImage", 0)
+
+    assert program.source == "\n".join(
+        [
+            'pytvpaint_status = "status ok"',
+            "tv_LayerSet 12",
+            "PARSE result pytvpaint_status_error pytvpaint_status_code",
+            'IF CMP(pytvpaint_status_error, "ERROR") == 1',
+            '    pytvpaint_status = CONCAT("status tv_LayerSet ", result)',
+            "ELSE",
+            "    tv_LayerPaste",
+            "    PARSE result pytvpaint_status_error pytvpaint_status_code",
+            '    IF CMP(pytvpaint_status_error, "ERROR") == 1',
+            '        pytvpaint_status = CONCAT("status paste ", result)',
+            "    ELSE",
+            "    END",
+            "    tv_LayerImage 0",
+        ]
+    )
+
+
+@pytest.mark.parametrize(
+    "status, error",
+    [
+        (["status tv_LayerSet ERROR -1"], "tv_LayerSet failed: 'ERROR -1'"),
+        ([], "stopped before writing its status"),
+        (["layer 1"], "stopped before writing its status"),
+    ],
+)
+def test_george_program_run_checked_error(
+    mock_tvpaint: MockTVPaint, status: list[str], error: str
+) -> None:
+    mock_tvpaint.respond_script("pytvpaint_status", status)
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", 12).check()
+
+    with pytest.raises(GeorgeError, match=error):
+        program.run_checked()
+
+
+def test_george_program_run_checked(mock_tvpaint: MockTVPaint) -> None:
+    mock_tvpaint.respond_script("pytvpaint_status", ["12", "status ok"])
+    program = GeorgeProgram()
+    program.cmd("tv_LayerSet", 12).check().write("result")
+
+    assert program.run_checked() == ["12"]
+    assert program.source.endswith(
+        "END\n" 'tv_WriteTextFile "append" pytvpaint_output pytvpaint_status'
+    )
+
+
 def test_send_cmd(tmp_path: Path) -> None:
     tmp_img = tmp_path / "out.png"
     send_cmd("tv_savemode", "png")
@@ -62,3 +172,92 @@ def test_send_cmd_error() -> None:
 def test_send_cmd_custom_error_value() -> None:
     with pytest.raises(GeorgeError, match="none"):
         send_cmd("tv_LayerGetID", -56, error_values=[GrgErrorValue.NONE])
+
+
+def test_send_cmd_future() -> None:
+    futures = [send_cmd_future("tv_Version") for _ in range(5)]
+    assert len({future.result() for future in futures}) == 1
+
+
+def test_send_cmds() -> None:
+    version, width = send_cmds([("tv_Version",), ("tv_GetWidth",)])
+    assert version == send_cmd("tv_Version")
+    assert int(width) > 0
+
+
+def test_send_cmds_error() -> None:
+    with pytest.raises(GeorgeError, match="none"):
+        send_cmds([("tv_LayerGetID", -56)], error_values=[GrgErrorValue.NONE])
+
+
+def test_batch(tmp_path: Path) -> None:
+    tmp_img = tmp_path / "out.png"
+
+    with batch() as commands:
+        assert send_cmd("tv_savemode", "png") == ""
+        send_cmd("tv_SaveImage", tmp_img)
+        assert len(commands) == 2
+        assert not tmp_img.exists()
+
+    assert tmp_img.exists()
+    assert len(commands.results) == 2
+
+
+def test_batch_error() -> None:
+    with pytest.raises(GeorgeError, match="none"):
+        with batch():
+            send_cmd("tv_LayerGetID", -56, error_values=[GrgErrorValue.NONE])
+
+
+def test_batch_result_unavailable(mock_tvpaint: MockTVPaint) -> None:
+    with pytest.raises(RuntimeError, match="tv_LayerCreate can't be read inside a"):
+        with batch():
+            int(send_cmd("tv_LayerCreate", "layer"))
+
+    with pytest.raises(RuntimeError, match="tv_LayerInfo can't be read inside a"):
+        with batch():
+            tv_parse_list(send_cmd("tv_LayerInfo", 1), [("name", str)])
+
+    assert mock_tvpaint.commands == []
+
+
+def test_batch_timeout() -> None:
+    with MockTVPaint({"tv_Version": "11.5"}, latency=2) as server:
+        client = JSONRPCClient(server.url, timeout=0.5, heartbeat=0)
+        client.connect()
+
+        with use_client(client), pytest.raises(TimeoutError):
+            with batch():
+                future = send_cmd_future("tv_Version")
+        assert isinstance(future.exception(), TimeoutError)
+
+        client.disconnect()
+
+
+def test_use_client() -> None:
+    client = JSONRPCClient("ws://localhost:3001")
+    assert get_client() is get_default_client()
+
+    with use_client(client):
+        assert get_client() is client
+
+    assert get_client() is get_default_client()
+
+
+def test_connect() -> None:
+    with connect() as client:
+        assert get_client() is client
+        assert send_cmd("tv_Version")
+
+    assert not client.is_connected
+    assert get_client() is get_default_client()
+
+
+def test_create_client_refused() -> None:
+    with MockTVPaint() as server:
+        port = server.port
+
+    start = time.monotonic()
+    with pytest.raises(ConnectionRefusedError):
+        create_client("ws://127.0.0.1", port, timeout=1)
+    assert time.monotonic() - start < 2
@@ -0,0 +1,80 @@
+from __future__ import annotations
+
+import json
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from pytvpaint.george.client import metrics, send_cmd
+from pytvpaint.george.client.metrics import LATENCY_BUCKETS, Metrics, profile
+from tests.mock_server import MockTVPaint
+
+
+@pytest.fixture
+def collector() -> Metrics:
+    collector = Metrics(enabled=True)
+    collector.record("tv_LayerInfo", 0.002, bytes_sent=15, bytes_received=40)
+    collector.record("tv_LayerInfo", 0.004, bytes_sent=15, bytes_received=40)
+    collector.record("tv_Version", 0.5, bytes_sent=10, bytes_received=30, error=True)
+    return collector
+
+
+def test_metrics_record(collector: Metrics) -> None:
+    stats = collector.commands["tv_LayerInfo"]
+    assert stats.calls == 2
+    assert stats.errors == 0
+    assert stats.total_time == pytest.approx(0.006)
+    assert stats.mean_time == pytest.approx(0.003)
+    assert stats.max_time == pytest.approx(0.004)
+    assert stats.bytes_sent == 30
+    assert stats.bytes_received == 80
+    assert sum(stats.histogram) == 2
+    assert len(stats.histogram) == len(LATENCY_BUCKETS) + 1
+
+
+def test_metrics_top(collector: Metrics) -> None:
+    assert [command for command, _ in collector.top(1)] == ["tv_Version"]
+
+
+def test_metrics_to_json(collector: Metrics) -> None:
+    data = json.loads(collector.to_json())
+    assert data["commands"]["tv_Version"]["errors"] == 1
+    assert data["commands"] == collector.to_dict()
+
+
+def test_metrics_to_prometheus(collector: Metrics) -> None:
+    text = collector.to_prometheus()
+    histogram = "pytvpaint_george_command_duration_seconds"
+    assert f"# TYPE {histogram} histogram" in text
+    assert f'{histogram}_bucket{{command="tv_LayerInfo",le="+Inf"}} 2' in text
+    assert f'{histogram}_count{{command="tv_Version"}} 1' in text
+    assert 'pytvpaint_george_command_errors_total{command="tv_Version"} 1' in text
+
+
+def test_metrics_reset(collector: Metrics) -> None:
+    collector.reset()
+    assert collector.to_dict() == {}
+
+
+def test_metrics_profile(capsys: pytest.CaptureFixture[str]) -> None:
+    assert not metrics.is_recording()
+
+    with profile() as profiler:
+        assert metrics.is_recording()
+        metrics.record("tv_LayerInfo", 0.01)
+
+    assert not metrics.is_recording()
+    assert profiler.commands["tv_LayerInfo"].calls == 1
+    assert "tv_LayerInfo" in capsys.readouterr().out
+
+
+def test_metrics_profile_context(mock_tvpaint: MockTVPaint) -> None:
+    with profile() as profiler:
+        # The response is received by the reader thread, out of the profile context
+        send_cmd("tv_Version")
+
+        # The commands of the other threads aren't recorded
+        with ThreadPoolExecutor(1) as executor:
+            executor.submit(metrics.record, "tv_LayerInfo", 0.01).result()
+
+    assert list(profiler.commands) == ["tv_Version"]
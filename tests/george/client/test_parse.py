@@ -10,6 +10,8 @@ import pytest
 from pytvpaint.george.client.parse import (
     DataclassInstance,
     camel_to_pascal,
+    compile_caster,
+    compile_fields,
     tv_cast_to_type,
     tv_handle_string,
     tv_parse_dict,
@@ -83,6 +85,11 @@ def test_tv_cast_to_enum_index_out_of_bounds() -> None:
         tv_cast_to_type("67", EnumTest)
 
 
+def test_compile_caster_cached() -> None:
+    assert compile_caster(EnumTest) is compile_caster(EnumTest)
+    assert compile_caster(tuple[float, float])("0.5 1") == (0.5, 1.0)
+
+
 @dataclass
 class Person:
     name: str
@@ -228,3 +235,14 @@ def test_tv_parse_list(
 ) -> None:
     result_dict = tv_parse_list(list_str, with_fields=with_type)
     assert result_dict == check_keys
+
+
+def test_compile_fields() -> None:
+    compiled = compile_fields(Project)
+    assert compile_fields(Project) is compiled
+    assert [(name, key) for name, key, _ in compiled] == [
+        ("name", "name"),
+        ("id", "id"),
+        ("frame_rate", "framerate"),
+        ("path", "path"),
+    ]
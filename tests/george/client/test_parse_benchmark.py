@@ -0,0 +1,40 @@
+"""Microbenchmarks of the George parsers, run them with `pytest -s` to see the timings."""
+
+from __future__ import annotations
+
+from pytvpaint.george.client.parse import tv_parse_dict, tv_parse_list
+from pytvpaint.george.grg_camera import TVPCameraPoint
+from pytvpaint.george.grg_clip import TVPClip
+from pytvpaint.george.grg_layer import LayerType, TVPLayer
+from tests.conftest import Benchmark
+
+
+def test_benchmark_parse_layer(benchmark: Benchmark) -> None:
+    result = benchmark(
+        tv_parse_list,
+        'ON 0 100 "Layer 1" IMAGE 0 24 0 0 1 0 OFF',
+        with_fields=TVPLayer,
+        unused_indices=[7, 8],
+    )
+    assert result["name"] == "Layer 1"
+    assert result["type"] == LayerType.IMAGE
+    assert result["last_frame"] == 24
+
+
+def test_benchmark_parse_clip(benchmark: Benchmark) -> None:
+    result = benchmark(
+        tv_parse_dict,
+        'name "Clip 1" isCurrent 1 isHidden 0 isSelected 1 storyboardStartFrame 0 '
+        "firstFrame 0 lastFrame 24 frameCount 25 markIn -1 markOut -1 colorIdx 3",
+        with_fields=TVPClip,
+    )
+    assert result["name"] == "Clip 1"
+    assert result["frame_count"] == 25
+    assert result["color_idx"] == 3
+
+
+def test_benchmark_parse_camera_point(benchmark: Benchmark) -> None:
+    result = benchmark(
+        tv_parse_list, "960.5 540.25 0 1.5", with_fields=TVPCameraPoint
+    )
+    assert result == {"x": 960.5, "y": 540.25, "angle": 0.0, "scale": 1.5}
@@ -1,12 +1,26 @@
 from __future__ import annotations
 
+import itertools
+import json
+import queue
+import time
+from concurrent.futures import ThreadPoolExecutor
 from typing import Any
 
 import pytest
 from pytest_mock import MockFixture
-from websocket import WebSocket
+from websocket import WebSocket, WebSocketTimeoutException
 
-from pytvpaint.george.client.rpc import JSONRPCClient
+from pytvpaint.george.client import send_cmd, use_client
+from pytvpaint.george.client.rpc import (
+    JSONRPCClient,
+    JSONRPCResponseError,
+    _json_codec,
+    backoff_delays,
+    json_dumps,
+    json_loads,
+)
+from tests.mock_server import MockTVPaint
 
 
 @pytest.fixture
@@ -14,7 +28,13 @@ def json_rpc_client(mocker: MockFixture) -> JSONRPCClient:
     def connect(w: WebSocket, url: str, **options: Any) -> None:
         w.connected = True
 
+    def recv(w: WebSocket) -> str:
+        # An idle socket times out without being closed
+        time.sleep(0.01)
+        raise WebSocketTimeoutException()
+
     mocker.patch.object(WebSocket, "connect", connect)
+    mocker.patch.object(WebSocket, "recv", recv)
     return JSONRPCClient("ws://localhost:3000")
 
 
@@ -22,6 +42,11 @@ def test_rpc_connect(mocker: MockFixture, json_rpc_client: JSONRPCClient) -> Non
     json_rpc_client.connect()
     assert json_rpc_client.is_connected
 
+    # The reader keeps waiting when there's no traffic
+    time.sleep(0.1)
+    assert json_rpc_client.is_connected
+    assert json_rpc_client.ready.is_set()
+
 
 def test_rpc_increment_id(json_rpc_client: JSONRPCClient) -> None:
     assert json_rpc_client.rpc_id == 0
@@ -37,20 +62,29 @@ def test_rpc_increment_max_sys_int(json_rpc_client: JSONRPCClient) -> None:
     assert json_rpc_client.rpc_id == 0
 
 
+@pytest.fixture
+def responses(mocker: MockFixture) -> queue.Queue[str]:
+    """Queue of messages returned by the mocked WebSocket.recv."""
+    messages: queue.Queue[str] = queue.Queue()
+
+    def recv(w: WebSocket) -> str | bytes:
+        return messages.get()
+
+    mocker.patch.object(WebSocket, "recv", recv)
+    return messages
+
+
 def test_rpc_execute_remote(
-    mocker: MockFixture, json_rpc_client: JSONRPCClient
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
 ) -> None:
-    def send(*args: Any) -> int:
-        return 0
-
     json_response_test = (
         '{"id": 0, "jsonrpc": "2.0", "result": "TVP Animation 11 Pro 11.5.3 fr"}'
     )
 
-    def recv(w: WebSocket) -> str | bytes:
-        return json_response_test
+    def send(*args: Any) -> int:
+        responses.put(json_response_test)
+        return 0
 
-    mocker.patch.object(WebSocket, "recv", recv)
     mocker.patch.object(WebSocket, "send", send)
 
     json_rpc_client.connect()
@@ -60,3 +94,255 @@ def test_rpc_execute_remote(
         "jsonrpc": "2.0",
         "result": "TVP Animation 11 Pro 11.5.3 fr",
     }
+
+
+def test_rpc_submit_remote_pipelined(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    sent: list[dict[str, Any]] = []
+
+    def send(w: WebSocket, payload: str) -> int:
+        sent.append(json.loads(payload))
+        return 0
+
+    mocker.patch.object(WebSocket, "send", send)
+
+    json_rpc_client.connect()
+    futures = [json_rpc_client.submit_remote("push", [i]) for i in range(3)]
+
+    assert [payload["id"] for payload in sent] == [0, 1, 2]
+    assert not any(future.done() for future in futures)
+
+    # Responses can come back in any order, they are matched by id
+    for rpc_id in (2, 0, 1):
+        responses.put(json.dumps({"id": rpc_id, "jsonrpc": "2.0", "result": rpc_id}))
+
+    assert [future.result(timeout=1)["result"] for future in futures] == [0, 1, 2]
+
+
+def test_rpc_submit_remote_error(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    error = {"code": -32601, "message": "Method not found"}
+
+    def send(*args: Any) -> int:
+        responses.put(json.dumps({"id": 0, "jsonrpc": "2.0", "error": error}))
+        return 0
+
+    mocker.patch.object(WebSocket, "send", send)
+
+    json_rpc_client.connect()
+    with pytest.raises(JSONRPCResponseError, match="Method not found"):
+        json_rpc_client.execute_remote("unknown")
+
+
+def test_rpc_invalid_message_skipped(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    def send(*args: Any) -> int:
+        responses.put("not json")
+        responses.put(json.dumps({"id": 0, "jsonrpc": "2.0", "result": "ok"}))
+        return 0
+
+    mocker.patch.object(WebSocket, "send", send)
+
+    json_rpc_client.connect()
+    assert json_rpc_client.execute_remote("push")["result"] == "ok"
+
+
+def test_rpc_error_without_id_fails_pending(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    error = {"code": -32700, "message": "Parse error"}
+
+    def send(*args: Any) -> int:
+        responses.put(json.dumps({"id": None, "jsonrpc": "2.0", "error": error}))
+        return 0
+
+    mocker.patch.object(WebSocket, "send", send)
+
+    json_rpc_client.connect()
+    with pytest.raises(JSONRPCResponseError, match="Parse error"):
+        json_rpc_client.execute_remote("push")
+
+
+def test_rpc_execute_remote_timeout(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    mocker.patch.object(WebSocket, "send", lambda *args: 0)
+
+    client = JSONRPCClient("ws://localhost:3000", timeout=1, heartbeat=0)
+    client.connect()
+    with pytest.raises(TimeoutError):
+        client.execute_remote("push")
+    assert client._pending == {}
+
+
+def test_rpc_submit_remote_batch(
+    mocker: MockFixture, json_rpc_client: JSONRPCClient, responses: queue.Queue[str]
+) -> None:
+    frames: list[Any] = []
+
+    def send(w: WebSocket, payload: str) -> int:
+        requests = json.loads(payload)
+        frames.append(requests)
+        batch_response = [
+            {"id": request["id"], "jsonrpc": "2.0", "result": request["params"][0]}
+            for request in reversed(requests)
+        ]
+        responses.put(json.dumps(batch_response))
+        return 0
+
+    mocker.patch.object(WebSocket, "send", send)
+
+    json_rpc_client.connect()
+    futures = json_rpc_client.submit_remote_batch([("push", ["a"]), ("push", ["b"])])
+
+    assert len(frames) == 1
+    assert [request["id"] for request in frames[0]] == [0, 1]
+    assert [future.result(timeout=1)["result"] for future in futures] == ["a", "b"]
+
+
+def test_rpc_submit_remote_batch_empty(json_rpc_client: JSONRPCClient) -> None:
+    json_rpc_client.connect()
+    assert json_rpc_client.submit_remote_batch([]) == []
+
+
+def test_rpc_mock_server() -> None:
+    with MockTVPaint({"tv_Version": '"TVPaint Animation" 11.5 en'}) as server:
+        client = JSONRPCClient(server.url)
+        client.connect()
+
+        response = client.execute_remote("execute_george", ["tv_Version"])
+        assert response["result"] == '"TVPaint Animation" 11.5 en'
+
+        futures = client.submit_remote_batch(
+            [("execute_george", ["tv_Version"]), ("unknown", [])]
+        )
+        assert futures[0].result(timeout=1)["result"].startswith('"TVPaint')
+        with pytest.raises(JSONRPCResponseError, match="Method not found"):
+            futures[1].result(timeout=1)
+
+        assert server.requests == 2
+        client.disconnect()
+
+
+def test_rpc_timeout_forgets_request() -> None:
+    with MockTVPaint({"tv_Version": "11.5"}, latency=1.5) as server:
+        client = JSONRPCClient(server.url, timeout=1)
+        client.connect()
+
+        with use_client(client):
+            with pytest.raises(TimeoutError):
+                send_cmd("tv_Version")
+            assert client._pending == {}
+
+            # The late response is skipped, the next request gets its own
+            server.latency = 0
+            assert send_cmd("tv_Version", "next") == "11.5"
+        client.disconnect()
+
+
+def test_rpc_concurrent_threads() -> None:
+    with MockTVPaint({"tv_LayerGetID": lambda args: f"id_{args[0]}"}) as server:
+        client = JSONRPCClient(server.url)
+        client.connect()
+
+        def worker(thread: int) -> list[bool]:
+            results = []
+            for i in range(50):
+                cmd = f"tv_LayerGetID {thread * 100 + i}"
+                response = client.execute_remote("execute_george", [cmd])
+                results.append(response["result"] == f"id_{thread * 100 + i}")
+            return results
+
+        with ThreadPoolExecutor(8) as executor:
+            results = [ok for oks in executor.map(worker, range(8)) for ok in oks]
+
+        assert len(results) == 400
+        assert all(results)
+        client.disconnect()
+
+
+def test_rpc_disconnect_fails_pending() -> None:
+    with MockTVPaint(latency=0.5) as server:
+        client = JSONRPCClient(server.url)
+        client.connect()
+
+        # A cancelled request doesn't break the dispatch of the other responses
+        client.submit_remote("execute_george", ["tv_Version"]).cancel()
+        future = client.submit_remote("execute_george", ["tv_Version"])
+        client.disconnect()
+
+        with pytest.raises(ConnectionError, match="Disconnected"):
+            future.result(timeout=1)
+
+
+def test_rpc_connection_lost_fails_pending() -> None:
+    server = MockTVPaint(latency=0.5)
+    server.start()
+    client = JSONRPCClient(server.url)
+    client.connect()
+
+    future = client.submit_remote("execute_george", ["tv_Version"])
+    server.stop()
+
+    with pytest.raises(ConnectionError):
+        future.result(timeout=2)
+    client.disconnect()
+
+
+def test_backoff_delays() -> None:
+    delays = list(itertools.islice(backoff_delays(0.1, 1), 6))
+    maximums = [0.1, 0.2, 0.4, 0.8, 1, 1]
+    assert all(m / 2 <= d <= m for d, m in zip(delays, maximums))
+
+
+def test_rpc_fast_disconnect() -> None:
+    with MockTVPaint() as server:
+        client = JSONRPCClient(server.url)
+        client.connect()
+        assert client.ready.is_set()
+
+        start = time.monotonic()
+        client.disconnect()
+        assert time.monotonic() - start < 0.5
+        assert not client.ready.is_set()
+
+
+def test_rpc_connection_lost_closes_socket() -> None:
+    server = MockTVPaint()
+    server.start()
+    client = JSONRPCClient(server.url, heartbeat=0)
+    client.connect()
+
+    server.stop()
+    deadline = time.monotonic() + 2
+    while client.ready.is_set() and time.monotonic() < deadline:
+        time.sleep(0.01)
+
+    assert not client.ready.is_set()
+    assert not client.is_connected
+    client.disconnect()
+
+
+def test_rpc_no_heartbeat_reconnects() -> None:
+    with MockTVPaint({"tv_Version": "11.5"}) as server:
+        client = JSONRPCClient(server.url, heartbeat=0)
+        client.connect()
+        assert client.ping_thread is None
+
+        client.ws_handle.close()
+        response = client.execute_remote("execute_george", ["tv_Version"])
+        assert response["result"] == "11.5"
+        client.disconnect()
+
+
+def test_json_codec(monkeypatch: pytest.MonkeyPatch) -> None:
+    value = {"jsonrpc": "2.0", "id": 1, "params": ['tv_LayerRename 1 "é à"']}
+    assert json_loads(json_dumps(value)) == value
+
+    monkeypatch.setenv("PYTVPAINT_WS_JSON", "json")
+    library, dumps, loads = _json_codec()
+    assert library == "json"
+    assert loads(dumps(value)) == value
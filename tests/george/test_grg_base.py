@@ -18,6 +18,7 @@ from pytvpaint.george.grg_base import (
     RGBColor,
     SaveFormat,
     TVPShape,
+    transaction,
     tv_alpha_load_mode_get,
     tv_alpha_load_mode_set,
     tv_alpha_save_mode_get,
@@ -49,9 +50,11 @@ from pytvpaint.george.grg_base import (
     tv_text_brush,
     tv_undo,
     tv_version,
+    undoable,
 )
-from pytvpaint.george.grg_layer import tv_layer_info
+from pytvpaint.george.grg_layer import tv_layer_display_set, tv_layer_info
 from pytvpaint.george.grg_project import TVPProject
+from tests.mock_server import MockTVPaint
 
 
 def test_tv_version() -> None:
@@ -312,3 +315,64 @@ def test_tv_text(
 @pytest.mark.parametrize("text", ["", "Hello", "sp a c e s", "$$"])
 def test_tv_text_brush(text: str) -> None:
     tv_text_brush(text)
+
+
+def test_undoable_error(mock_tvpaint: MockTVPaint) -> None:
+    @undoable
+    def fail() -> None:
+        raise ValueError("Failed")
+
+    with pytest.raises(ValueError):
+        fail()
+
+    assert mock_tvpaint.commands == ["tv_UndoOpenStack", "tv_UndoCloseStack fail"]
+
+
+def test_transaction(mock_tvpaint: MockTVPaint) -> None:
+    mock_tvpaint.respond("tv_LayerDisplay", "1")
+
+    with transaction("hide"):
+        for layer_id in range(10):
+            tv_layer_display_set(layer_id, False)
+
+    # The undo stack and the commands are sent in a single batch request
+    assert mock_tvpaint.requests == 1
+    assert mock_tvpaint.commands[0] == "tv_UndoOpenStack"
+    assert mock_tvpaint.commands[-1] == "tv_UndoCloseStack hide"
+    assert len(mock_tvpaint.commands) == 12
+
+
+def test_transaction_rollback(mock_tvpaint: MockTVPaint) -> None:
+    mock_tvpaint.respond("tv_LayerDisplay", lambda args: "0" if args[0] == "5" else "1")
+
+    with pytest.raises(GeorgeError), transaction("hide"):
+        for layer_id in range(10):
+            tv_layer_display_set(layer_id, False)
+
+    assert mock_tvpaint.commands[-2:] == ["tv_UndoCloseStack hide", "tv_Undo"]
+
+
+def test_transaction_nested(mock_tvpaint: MockTVPaint) -> None:
+    mock_tvpaint.respond("tv_LayerDisplay", lambda args: "0" if args[0] == "5" else "1")
+
+    with pytest.raises(GeorgeError), transaction("outer"):
+        tv_layer_display_set(1, False)
+        with transaction("inner"):
+            tv_layer_display_set(5, False)
+
+    # The nested transaction is sent with the outer one, which is undone as a whole
+    assert mock_tvpaint.requests == 2
+    assert mock_tvpaint.commands[-3:] == [
+        "tv_UndoCloseStack inner",
+        "tv_UndoCloseStack outer",
+        "tv_Undo",
+    ]
+
+
+def test_transaction_python_error(mock_tvpaint: MockTVPaint) -> None:
+    with pytest.raises(ValueError), transaction():
+        tv_layer_display_set(1, False)
+        raise ValueError("Failed")
+
+    # Nothing was sent so there's nothing to undo
+    assert mock_tvpaint.commands == []
@@ -9,10 +9,12 @@ from pytvpaint.george.grg_base import FieldOrder
 from pytvpaint.george.grg_camera import (
     TVPCameraPoint,
     tv_camera_enum_points,
+    tv_camera_enum_points_all,
     tv_camera_info_get,
     tv_camera_info_set,
     tv_camera_insert_point,
     tv_camera_interpolation,
+    tv_camera_interpolation_list,
     tv_camera_remove_point,
     tv_camera_set_point,
 )
@@ -72,6 +74,17 @@ def test_tv_camera_enum_points_wrong_index(test_project: TVPProject) -> None:
         tv_camera_enum_points(0)
 
 
+def test_tv_camera_enum_points_all(test_project: TVPProject) -> None:
+    assert tv_camera_enum_points_all() == []
+
+    tv_camera_insert_point(0, 0, 0, 0, 1)
+    tv_camera_insert_point(1, 50, 20, 0, 2)
+    assert tv_camera_enum_points_all() == [
+        tv_camera_enum_points(0),
+        tv_camera_enum_points(1),
+    ]
+
+
 def map_value(start: int, end: int, ratio: float) -> float:
     return start + (end - start) * ratio
 
@@ -93,6 +106,16 @@ def test_tv_camera_interpolation(test_project: TVPProject) -> None:
         assert round(inter.y) == map_value(start_y, end_y, ratio)
 
 
+def test_tv_camera_interpolation_list(test_project: TVPProject) -> None:
+    tv_camera_insert_point(0, 0, 0, 0, 1)
+    tv_camera_insert_point(1, 50, 50, 0, 3)
+
+    positions = [i / 10 for i in range(11)]
+    expected = [tv_camera_interpolation(position) for position in positions]
+    assert tv_camera_interpolation_list(positions) == expected
+    assert tv_camera_interpolation_list([]) == []
+
+
 def test_tv_camera_insert_point(test_project: TVPProject) -> None:
     point = TVPCameraPoint(50, 26, 0, scale=0.0)
     tv_camera_insert_point(0, point.x, point.y, point.angle, point.angle)
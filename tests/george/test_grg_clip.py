@@ -60,6 +60,8 @@ from pytvpaint.george.grg_clip import (
     tv_save_sequence,
     tv_sound_clip_adjust,
     tv_sound_clip_info,
+    tv_sound_clip_info_all,
+    tv_sound_clip_info_project,
     tv_sound_clip_new,
     tv_sound_clip_reload,
     tv_sound_clip_remove,
@@ -765,6 +767,23 @@ def test_tv_sound_clip_info(test_clip: TVPClip, wav_file: Path) -> None:
     assert Path(sound.path) == wav_file
 
 
+def test_tv_sound_clip_info_all(test_clip: TVPClip, wav_file: Path) -> None:
+    assert tv_sound_clip_info_all(test_clip.id) == []
+
+    for _ in range(3):
+        tv_sound_clip_new(wav_file)
+
+    sounds = tv_sound_clip_info_all(test_clip.id)
+    assert sounds == [tv_sound_clip_info(test_clip.id, i) for i in range(3)]
+
+
+def test_tv_sound_clip_info_project(test_clip: TVPClip, wav_file: Path) -> None:
+    tv_sound_clip_new(wav_file)
+
+    clip_sounds = dict(tv_sound_clip_info_project())
+    assert clip_sounds[test_clip.id] == [tv_sound_clip_info(test_clip.id, 0)]
+
+
 def test_tv_sound_clip_info_wrong_clip_id() -> None:
     with pytest.raises(GeorgeError):
         tv_sound_clip_info(-2, 0)
@@ -12,7 +12,13 @@ from pytvpaint.george.grg_base import (
     tv_rect,
     tv_save_mode_get,
 )
-from pytvpaint.george.grg_clip import TVPClip, tv_clip_current_id, tv_layer_image
+from pytvpaint.george.grg_clip import (
+    TVPClip,
+    tv_clip_current_id,
+    tv_clip_name_get,
+    tv_layer_image,
+    tv_layer_image_get,
+)
 from pytvpaint.george.grg_layer import (
     InsertDirection,
     InstanceNamingMode,
@@ -22,9 +28,15 @@ from pytvpaint.george.grg_layer import (
     LayerTransparency,
     StencilMode,
     TVPLayer,
+    tv_clip_layers_enum,
+    tv_exposure_duplicate,
+    tv_exposure_enum_starts_project,
+    tv_exposure_set,
     tv_instance_get_name,
     tv_instance_name,
+    tv_instance_names_enum,
     tv_instance_set_name,
+    tv_layer_add_instance,
     tv_layer_anim,
     tv_layer_auto_break_instance_get,
     tv_layer_auto_break_instance_set,
@@ -45,6 +57,7 @@ from pytvpaint.george.grg_layer import (
     tv_layer_color_unlock,
     tv_layer_color_unselect,
     tv_layer_color_visible,
+    tv_layer_colors_get,
     tv_layer_copy,
     tv_layer_create,
     tv_layer_current_id,
@@ -54,9 +67,13 @@ from pytvpaint.george.grg_layer import (
     tv_layer_display_get,
     tv_layer_display_set,
     tv_layer_duplicate,
+    tv_layer_exposure_break,
+    tv_layer_exposures_set,
     tv_layer_get_id,
     tv_layer_get_pos,
     tv_layer_info,
+    tv_layer_info_all,
+    tv_layer_info_project,
     tv_layer_insert_image,
     tv_layer_kill,
     tv_layer_load_dependencies,
@@ -66,16 +83,19 @@ from pytvpaint.george.grg_layer import (
     tv_layer_lock_set,
     tv_layer_mark_get,
     tv_layer_mark_set,
+    tv_layer_marks_enum,
     tv_layer_merge,
     tv_layer_merge_all,
     tv_layer_move,
     tv_layer_paste,
+    tv_layer_paste_at,
     tv_layer_post_behavior_get,
     tv_layer_post_behavior_set,
     tv_layer_pre_behavior_get,
     tv_layer_pre_behavior_set,
     tv_layer_rename,
     tv_layer_select,
+    tv_layer_select_copy,
     tv_layer_selection_get,
     tv_layer_selection_set,
     tv_layer_set,
@@ -84,6 +104,7 @@ from pytvpaint.george.grg_layer import (
     tv_layer_show_thumbnails_set,
     tv_layer_stencil_get,
     tv_layer_stencil_set,
+    tv_layers_set,
     tv_load_image,
     tv_preserve_get,
     tv_preserve_set,
@@ -126,6 +147,50 @@ def test_tv_layer_info_wrong_id() -> None:
         tv_layer_info(-4)
 
 
+def test_tv_layer_info_all(test_project: TVPProject) -> None:
+    for i in range(5):
+        tv_layer_create(f"layer_{i}")
+
+    infos = tv_layer_info_all(tv_clip_current_id())
+    assert len(infos) == 6
+    assert infos == [tv_layer_info(tv_layer_get_id(pos)) for pos in range(6)]
+
+
+def test_tv_layer_info_all_wrong_id() -> None:
+    with pytest.raises(NoObjectWithIdError):
+        tv_layer_info_all(-4)
+
+
+def test_tv_layer_info_project(test_project: TVPProject) -> None:
+    tv_layer_create("layer_1")
+
+    clip_layers = tv_layer_info_project()
+    clip_id = tv_clip_current_id()
+    assert dict(clip_layers)[clip_id] == tv_layer_info_all(clip_id)
+
+
+def test_tv_clip_layers_enum(test_project: TVPProject) -> None:
+    layer_id = tv_layer_create("layer_1")
+    tv_layer_color_set(layer_id, 3)
+
+    clip_id = tv_clip_current_id()
+    clip = next(c for c in tv_clip_layers_enum() if c.clip_id == clip_id)
+    assert clip.clip_name == tv_clip_name_get(clip_id)
+    assert clip.layers == tv_layer_info_all(clip_id)
+    assert clip.color_indices[clip.layers.index(tv_layer_info(layer_id))] == 3
+    assert tv_clip_current_id() == clip_id
+
+
+def test_tv_exposure_enum_starts_project(test_anim_layer: TVPLayer) -> None:
+    tv_layer_image(3)
+    clip_id = tv_clip_current_id()
+    layer = tv_layer_info(test_anim_layer.id)
+
+    starts = tv_exposure_enum_starts_project([(clip_id, [layer])])
+    assert starts == {layer.id: [layer.first_frame]}
+    assert tv_layer_image_get() == 3
+
+
 def test_tv_layer_move(test_project: TVPProject) -> None:
     current_layer = tv_layer_current_id()
     total_layers = 10
@@ -297,6 +362,31 @@ def test_tv_layer_lock_set_wrong_id(lock: bool) -> None:
         tv_layer_lock_set(-1, lock)
 
 
+def test_tv_layers_set(test_layer: TVPLayer) -> None:
+    other_layer = tv_layer_create("other")
+    layer_ids = [test_layer.id, other_layer]
+
+    tv_layers_set(layer_ids, visible=False, locked=True, color_index=2)
+    for layer_id in layer_ids:
+        assert not tv_layer_display_get(layer_id)
+        assert tv_layer_lock_get(layer_id)
+        assert tv_layer_color_get(layer_id) == 2
+
+    tv_layers_set(layer_ids, visible=True)
+    assert all(tv_layer_display_get(layer_id) for layer_id in layer_ids)
+    assert tv_layer_lock_get(test_layer.id)
+
+    tv_layers_set(layer_ids, locked=False)
+    tv_layer_kill(other_layer)
+
+
+def test_tv_layers_set_wrong_id(test_layer: TVPLayer) -> None:
+    with pytest.raises(GeorgeError):
+        tv_layers_set([-1, test_layer.id], locked=True)
+    assert tv_layer_lock_get(test_layer.id)
+    tv_layer_lock_set(test_layer.id, False)
+
+
 def test_tv_layer_collapse_get() -> None:
     tv_layer_collapse_get(tv_layer_current_id())
 
@@ -543,6 +633,24 @@ def test_tv_layer_mark_set_wrong_id() -> None:
         tv_layer_mark_set(-1, 0, 0)
 
 
+def test_tv_layer_marks_enum(test_anim_layer: TVPLayer) -> None:
+    tv_layer_insert_image(count=4, direction=InsertDirection.AFTER)
+    for frame in range(1, 4):
+        tv_layer_mark_set(test_anim_layer.id, frame, frame)
+
+    marks = tv_layer_marks_enum([(test_anim_layer.id, 0, 4)])
+    assert marks == [(test_anim_layer.id, frame, frame) for frame in range(1, 4)]
+
+
+def test_tv_layer_marks_enum_empty() -> None:
+    assert tv_layer_marks_enum([]) == []
+
+
+def test_tv_layer_marks_enum_wrong_id() -> None:
+    with pytest.raises(NoObjectWithIdError):
+        tv_layer_marks_enum([(-1, 0, 0)])
+
+
 def test_tv_layer_anim(test_layer: TVPLayer) -> None:
     tv_layer_anim(test_layer.id)
 
@@ -568,6 +676,17 @@ def test_tv_layer_color_get_color_wrong_id() -> None:
         tv_layer_color_get_color(-1, 0)
 
 
+def test_tv_layer_colors_get() -> None:
+    current_clip = tv_clip_current_id()
+    colors = tv_layer_colors_get(current_clip)
+    assert colors == [tv_layer_color_get_color(current_clip, i) for i in range(26)]
+
+
+def test_tv_layer_colors_get_wrong_id() -> None:
+    with pytest.raises(NoObjectWithIdError):
+        tv_layer_colors_get(-1)
+
+
 # We skip index 0 because it's the "Default" color and can't be changed
 @pytest.mark.parametrize("color_index", range(1, 27))
 @pytest.mark.parametrize("name", [None, "test"])
@@ -809,6 +928,17 @@ def test_tv_instance_set_name_wrong_id() -> None:
         tv_instance_set_name(-1, 0, "test")
 
 
+def test_tv_instance_names_enum(test_layer: TVPLayer) -> None:
+    tv_instance_set_name(test_layer.id, 0, "first name")
+    assert tv_instance_names_enum(test_layer.id, [0]) == ["first name"]
+    assert tv_instance_names_enum(test_layer.id, []) == []
+
+
+def test_tv_instance_names_enum_wrong_id() -> None:
+    with pytest.raises(NoObjectWithIdError):
+        tv_instance_names_enum(-1, [0])
+
+
 def instance_exists(frame: int) -> bool:
     try:
         tv_instance_get_name(tv_layer_current_id(), frame)
@@ -889,6 +1019,56 @@ def test_tv_layer_insert_image(
         offset += 1
 
 
+@pytest.mark.parametrize("count", [1, 3])
+@pytest.mark.parametrize("split", [True, False])
+def test_tv_layer_add_instance(
+    test_anim_layer: TVPLayer, count: int, split: bool
+) -> None:
+    layers_before = len(tv_layer_info_all(tv_clip_current_id()))
+    tv_layer_image(2)
+
+    tv_layer_add_instance(test_anim_layer.id, "temp", 0, 10, count, split=split)
+
+    assert tv_layer_current_id() == test_anim_layer.id
+    assert tv_layer_image_get() == 2
+    assert len(tv_layer_info_all(tv_clip_current_id())) == layers_before
+    assert instance_exists(10)
+    if count > 1:
+        # Only split instances have an image at their last frame
+        assert instance_exists(10 + count - 1) == split
+
+
+def test_tv_exposure_duplicate(test_anim_layer: TVPLayer) -> None:
+    tv_exposure_duplicate(test_anim_layer.id, 0, 1, 5, 1)
+
+    assert tv_layer_current_id() == test_anim_layer.id
+    assert instance_exists(5)
+
+
+def test_tv_layer_exposure_break(test_anim_layer: TVPLayer) -> None:
+    tv_exposure_set(0, 5)
+    tv_layer_exposure_break(test_anim_layer.id, 3)
+    assert instance_exists(3)
+
+
+def test_tv_layer_exposures_set(test_anim_layer: TVPLayer) -> None:
+    tv_exposure_set(0, 2)
+    tv_layer_exposure_break(test_anim_layer.id, 1)
+    tv_layer_exposures_set(test_anim_layer.id, [(0, 3), (1, 2)])
+
+    assert tv_layer_current_id() == test_anim_layer.id
+    assert instance_exists(3)
+    assert not instance_exists(1)
+
+
+def test_tv_layer_select_copy_paste_at(test_anim_layer: TVPLayer) -> None:
+    tv_layer_select_copy(test_anim_layer.id, 0, 1)
+    tv_layer_paste_at(test_anim_layer.id, 5)
+
+    assert tv_layer_current_id() == test_anim_layer.id
+    assert instance_exists(5)
+
+
 @pytest.mark.parametrize("start", [0, 5, 10, 100])
 def test_tv_layer_shift(test_layer: TVPLayer, start: int) -> None:
     tv_layer_shift(test_layer.id, start)
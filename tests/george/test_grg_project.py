@@ -59,6 +59,7 @@ from pytvpaint.george.grg_project import (
     tv_save_project,
     tv_sound_project_adjust,
     tv_sound_project_info,
+    tv_sound_project_info_all,
     tv_sound_project_new,
     tv_sound_project_reload,
     tv_sound_project_remove,
@@ -409,6 +410,16 @@ def test_tv_sound_project_info(test_project: TVPProject, wav_file: Path) -> None
     tv_sound_project_info(test_project.id, 0)
 
 
+def test_tv_sound_project_info_all(test_project: TVPProject, wav_file: Path) -> None:
+    assert tv_sound_project_info_all(test_project.id) == []
+
+    for _ in range(3):
+        tv_sound_project_new(wav_file)
+
+    sounds = tv_sound_project_info_all(test_project.id)
+    assert sounds == [tv_sound_project_info(test_project.id, i) for i in range(3)]
+
+
 def test_tv_sound_project_info_wrong_project_id() -> None:
     with pytest.raises(GeorgeError):
         tv_sound_project_info("lo", 0)
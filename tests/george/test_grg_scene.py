@@ -5,8 +5,11 @@ from collections.abc import Iterator
 import pytest
 
 from pytvpaint.george.exceptions import GeorgeError
+from pytvpaint.george.grg_clip import tv_clip_enum_id, tv_clip_name_get
 from pytvpaint.george.grg_project import TVPProject
 from pytvpaint.george.grg_scene import (
+    tv_clip_names_enum,
+    tv_scene_clips_enum,
     tv_scene_close,
     tv_scene_current_id,
     tv_scene_duplicate,
@@ -27,6 +30,23 @@ def test_tv_scene_enum_id_wrong_pos(pos: int) -> None:
         tv_scene_enum_id(-1)
 
 
+def test_tv_scene_clips_enum(test_project: TVPProject) -> None:
+    scenes = tv_scene_clips_enum()
+    assert scenes
+    for scene_pos, (scene_id, clip_ids) in enumerate(scenes):
+        assert tv_scene_enum_id(scene_pos) == scene_id
+        for clip_pos, clip_id in enumerate(clip_ids):
+            assert tv_clip_enum_id(scene_id, clip_pos) == clip_id
+
+
+def test_tv_clip_names_enum(test_project: TVPProject) -> None:
+    clips = tv_clip_names_enum()
+    scenes = tv_scene_clips_enum()
+    assert [(s, c) for s, c, _ in clips] == [(s, c) for s, ids in scenes for c in ids]
+    for _, clip_id, name in clips:
+        assert tv_clip_name_get(clip_id) == name
+
+
 def test_tv_scene_current_id(test_project: TVPProject) -> None:
     assert tv_scene_current_id()
 
@@ -0,0 +1,377 @@
+"""In-process mock of the tvpaint-rpc WebSocket server, to test and benchmark the client stack without TVPaint.
+
+The server speaks the same JSON-RPC protocol as the plugin (an `execute_george` method with the George command as
+parameter) and answers with scripted responses, optionally after a fixed latency to simulate TVPaint's processing time.
+"""
+
+from __future__ import annotations
+
+import base64
+import contextlib
+import hashlib
+import json
+import re
+import shlex
+import socket
+import struct
+import threading
+import time
+from collections.abc import Mapping
+from pathlib import Path
+from types import TracebackType
+from typing import Any, Callable, Union
+
+# A fixed response or a function of the command arguments
+Response = Union[str, Callable[[list[str]], str]]
+# Fixed lines or a function of the script source, written to the `run_inline_script` output file
+ScriptResponse = Union[list[str], Callable[[str], list[str]]]
+
+_WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+_OUTPUT_HEADER = re.compile(r'pytvpaint_output = "(.*)"')
+
+_OPCODE_CONTINUATION = 0x0
+_OPCODE_TEXT = 0x1
+_OPCODE_CLOSE = 0x8
+_OPCODE_PING = 0x9
+_OPCODE_PONG = 0xA
+
+
+class MockTVPaint:
+    """A JSON-RPC WebSocket server that answers George commands like TVPaint with the tvpaint-rpc plugin.
+
+    Example:
+        ```python
+        with MockTVPaint(latency=0.001) as server:
+            server.respond("tv_LayerCurrentId", "12")
+            with use_client(create_client(port=server.port)):
+                assert george.tv_layer_current_id() == 12
+            assert server.commands == ["tv_LayerCurrentId"]
+        ```
+
+    Attributes:
+        responses: the response of each George command, by lowercase command name
+        scripts: the responses of the inline scripts, by a text found in their source
+        default_response: the response of the commands without one
+        latency: the time in seconds the server waits before answering a message
+        commands: the George commands received, in order
+        requests: the number of JSON-RPC messages received, a batch request counts once
+    """
+
+    def __init__(
+        self,
+        responses: Mapping[str, Response] | None = None,
+        latency: float = 0.0,
+        default_response: str = "",
+        host: str = "127.0.0.1",
+        port: int = 0,
+    ) -> None:
+        """Create the server, it listens for connections once started.
+
+        Args:
+            responses: the response of each George command. Defaults to None.
+            latency: the time in seconds to wait before answering a message. Defaults to 0.0.
+            default_response: the response of the commands without one. Defaults to "".
+            host: the interface to listen on. Defaults to "127.0.0.1".
+            port: the port to listen on, a free one if 0. Defaults to 0.
+        """
+        self.responses: dict[str, Response] = {}
+        self.scripts: dict[str, ScriptResponse] = {}
+        self.default_response = default_response
+        self.latency = latency
+        self.commands: list[str] = []
+        self.requests = 0
+
+        for command, response in (responses or {}).items():
+            self.respond(command, response)
+
+        self._socket = socket.create_server((host, port))
+        self._connections: list[socket.socket] = []
+        self._lock = threading.Lock()
+        self._accept_thread: threading.Thread | None = None
+
+    def __enter__(self) -> MockTVPaint:
+        """Start the server."""
+        self.start()
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_value: BaseException | None,
+        traceback: TracebackType | None,
+    ) -> None:
+        """Stop the server."""
+        self.stop()
+
+    @property
+    def port(self) -> int:
+        """The port the server listens on."""
+        return int(self._socket.getsockname()[1])
+
+    @property
+    def url(self) -> str:
+        """The WebSocket url of the server."""
+        return f"ws://127.0.0.1:{self.port}"
+
+    def respond(self, command: str, response: Response) -> None:
+        """Set the response of a George command, a function gets the command arguments."""
+        self.responses[command.lower()] = response
+
+    def respond_script(self, marker: str, response: ScriptResponse) -> None:
+        """Set the lines written by the inline scripts whose source contains the marker, see `run_inline_script`."""
+        self.scripts[marker] = response
+
+    def reset_stats(self) -> None:
+        """Forget the received commands and requests."""
+        with self._lock:
+            self.commands.clear()
+            self.requests = 0
+
+    def start(self) -> None:
+        """Accept the connections in a thread."""
+        self._accept_thread = threading.Thread(target=self._accept, daemon=True)
+        self._accept_thread.start()
+
+    def stop(self) -> None:
+        """Close the server and the open connections."""
+        # Shutting down the sockets unblocks the threads waiting on them
+        for sock in [self._socket, *self._connections]:
+            with contextlib.suppress(OSError):
+                sock.shutdown(socket.SHUT_RDWR)
+        self._socket.close()
+        with self._lock:
+            connections, self._connections = self._connections, []
+        for connection in connections:
+            connection.close()
+        if self._accept_thread:
+            self._accept_thread.join()
+
+    def execute_george(self, command: str) -> str:
+        """Get the response of a George command."""
+        with self._lock:
+            self.commands.append(command)
+
+        try:
+            name, *args = shlex.split(command)
+        except ValueError:
+            name, *args = command.split()
+
+        if name.lower() == "tv_runscript" and self.scripts:
+            return self._run_script(Path(args[0]))
+
+        response = self.responses.get(name.lower(), self.default_response)
+        return response(args) if callable(response) else response
+
+    def _run_script(self, script: Path) -> str:
+        """Write the scripted lines of an inline script to its output file."""
+        source = script.read_text(encoding="utf-8")
+        header = _OUTPUT_HEADER.match(source)
+        response = next(
+            (lines for marker, lines in self.scripts.items() if marker in source),
+            None,
+        )
+        if not header or response is None:
+            return self.default_response
+
+        lines = response(source) if callable(response) else response
+        if lines:
+            output = Path(header.group(1))
+            output.write_text("".join(f"{line}\n" for line in lines), encoding="utf-8")
+        return ""
+
+    def _accept(self) -> None:
+        """Accept the connections until the server is closed."""
+        while True:
+            try:
+                connection, _ = self._socket.accept()
+            except OSError:
+                return
+            with self._lock:
+                self._connections.append(connection)
+            thread = threading.Thread(target=self._serve, args=(connection,))
+            thread.daemon = True
+            thread.start()
+
+    def _serve(self, connection: socket.socket) -> None:
+        """Answer the messages of a client until it disconnects."""
+        with connection:
+            try:
+                self._handshake(connection)
+                while True:
+                    message = _read_message(connection)
+                    if message is None:
+                        return
+                    response = self._handle_message(message)
+                    _send_frame(connection, _OPCODE_TEXT, response.encode("utf-8"))
+            except OSError:
+                return
+
+    @staticmethod
+    def _handshake(connection: socket.socket) -> None:
+        """Upgrade the HTTP connection to the WebSocket protocol."""
+        request = b""
+        while b"\r\n\r\n" not in request:
+            chunk = connection.recv(4096)
+            if not chunk:
+                raise ConnectionError("The client closed the connection")
+            request += chunk
+
+        key_match = re.search(rb"Sec-WebSocket-Key:\s*(\S+)", request, re.IGNORECASE)
+        if not key_match:
+            raise ConnectionError("Not a WebSocket handshake")
+
+        digest = hashlib.sha1(key_match.group(1) + _WEBSOCKET_GUID.encode()).digest()
+        accept = base64.b64encode(digest).decode()
+        connection.sendall(
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            f"Sec-WebSocket-Accept: {accept}\r\n\r\n".encode()
+        )
+
+    def _handle_message(self, message: str) -> str:
+        """Answer a JSON-RPC request or batch request."""
+        with self._lock:
+            self.requests += 1
+        if self.latency:
+            time.sleep(self.latency)
+
+        payload = json.loads(message)
+        if isinstance(payload, list):
+            return json.dumps([self._handle_request(request) for request in payload])
+        return json.dumps(self._handle_request(payload))
+
+    def _handle_request(self, request: dict[str, Any]) -> dict[str, Any]:
+        """Answer a single JSON-RPC request."""
+        response: dict[str, Any] = {"jsonrpc": "2.0", "id": request.get("id")}
+        if request.get("method") != "execute_george":
+            response["error"] = {"code": -32601, "message": "Method not found"}
+            return response
+
+        try:
+            response["result"] = self.execute_george(str(request["params"][0]))
+        except Exception as e:
+            response["error"] = {"code": -32603, "message": str(e)}
+        return response
+
+
+def _recv_exactly(connection: socket.socket, size: int) -> bytes:
+    """Receive a number of bytes from the socket."""
+    data = b""
+    while len(data) < size:
+        chunk = connection.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError("The client closed the connection")
+        data += chunk
+    return data
+
+
+def _read_message(connection: socket.socket) -> str | None:
+    """Read the next text message of a client, answering the pings. Returns None if the client closed the connection."""
+    fragments: list[bytes] = []
+
+    while True:
+        try:
+            first, second = _recv_exactly(connection, 2)
+        except ConnectionError:
+            return None
+
+        fin, opcode = first & 0x80, first & 0x0F
+        length = second & 0x7F
+        if length == 126:
+            (length,) = struct.unpack("!H", _recv_exactly(connection, 2))
+        elif length == 127:
+            (length,) = struct.unpack("!Q", _recv_exactly(connection, 8))
+
+        # The client frames are always masked
+        mask = _recv_exactly(connection, 4) if second & 0x80 else b"\0\0\0\0"
+        masked = _recv_exactly(connection, length)
+        key = (mask * (length // 4 + 1))[:length]
+        payload = (
+            int.from_bytes(masked, "big") ^ int.from_bytes(key, "big")
+        ).to_bytes(length, "big")
+
+        if opcode == _OPCODE_CLOSE:
+            _send_frame(connection, _OPCODE_CLOSE, payload[:2])
+            return None
+        if opcode == _OPCODE_PING:
+            _send_frame(connection, _OPCODE_PONG, payload)
+            continue
+        if opcode in (_OPCODE_TEXT, _OPCODE_CONTINUATION):
+            fragments.append(payload)
+            if fin:
+                return b"".join(fragments).decode("utf-8")
+
+
+def _send_frame(connection: socket.socket, opcode: int, payload: bytes) -> None:
+    """Send an unmasked frame, like the servers do."""
+    length = len(payload)
+    if length < 126:
+        header = struct.pack("!BB", 0x80 | opcode, length)
+    elif length < 1 << 16:
+        header = struct.pack("!BBH", 0x80 | opcode, 126, length)
+    else:
+        header = struct.pack("!BBQ", 0x80 | opcode, 127, length)
+    connection.sendall(header + payload)
+
+
+def respond_clip(
+    server: MockTVPaint,
+    layer_count: int = 20,
+    frame_count: int = 100,
+    exposure: int = 2,
+    mark_every: int = 10,
+) -> list[int]:
+    """Script the responses of a project with a clip of animation layers.
+
+    Args:
+        server: the mock server
+        layer_count: the number of layers of the clip. Defaults to 20.
+        frame_count: the number of frames of each layer. Defaults to 100.
+        exposure: the duration of each instance. Defaults to 2.
+        mark_every: the interval between the marks of each layer. Defaults to 10.
+
+    Returns:
+        the layer ids
+    """
+    layer_ids = [100 + position for position in range(layer_count)]
+
+    def layer_info(layer_id: int) -> str:
+        position = layer_id - 100
+        name = f'"layer_{position}"'
+        return f"ON {position} 100 {name} SEQUENCE 0 {frame_count - 1} 0 0 0 1 OFF"
+
+    def layer_get_id(args: list[str]) -> str:
+        position = int(args[0])
+        return str(layer_ids[position]) if position < layer_count else "none"
+
+    def layer_marks(source: str) -> list[str]:
+        marked_ids = re.findall(r"tv_LayerMarkGet (\d+) frame", source)
+        frames = range(0, frame_count, mark_every)
+        return [f"{layer_id} {frame} 1" for layer_id in marked_ids for frame in frames]
+
+    server.respond("tv_ProjectCurrentId", "7")
+    server.respond("tv_StartFrame", "0")
+    server.respond("tv_ClipCurrentId", "1")
+    server.respond("tv_LayerCurrentId", str(layer_ids[0]))
+    server.respond("tv_LayerGetID", layer_get_id)
+    server.respond("tv_LayerInfo", lambda args: layer_info(int(args[0])))
+    server.respond("tv_LayerColor", lambda args: f'{args[1]} {args[2]} 255 0 0 "red"')
+    server.respond("tv_SaveMode", "png")
+    server.respond("tv_AlphaSaveMode", "premultiply")
+    server.respond("tv_Background", "none")
+
+    server.respond_script(
+        "tv_ExposureNext",
+        [str(frame) for frame in range(0, frame_count, exposure)],
+    )
+    server.respond_script("tv_LayerMarkGet", layer_marks)
+    server.respond_script(
+        "tv_LayerInfo layer_id",
+        ["layers"] + [f"{layer_id} {layer_info(layer_id)}" for layer_id in layer_ids],
+    )
+    server.respond_script(
+        "tv_LayerColor", [f'1 {index} 255 0 0 "red"' for index in range(26)]
+    )
+
+    return layer_ids
@@ -81,7 +81,31 @@ def test_camera_get_point_data_at(current_camera: Camera) -> None:
     assert current_camera.get_point_data_at(1.0) == end.data
 
 
+def test_camera_sample(current_camera: Camera) -> None:
+    start = current_camera.insert_point(0, 50, 50, 10, 1.2)
+    end = current_camera.insert_point(1, 10, 5, 48, 0.4)
+
+    samples = current_camera.sample([-1.0, 0.0, 0.5, 1.0])
+    assert samples[:2] == [start.data, start.data]
+    assert samples[2] == current_camera.get_point_data_at(0.5)
+    assert samples[3] == end.data
+
+
+def test_camera_points_data(current_camera: Camera) -> None:
+    current_camera.insert_point(0, 50, 50, 34, 1.5)
+    current_camera.insert_point(1, 10, 5, 48, 0.4)
+    assert [point.data for point in current_camera.points] == (
+        current_camera.points_data
+    )
+
+
 def test_camera_remove_point(current_camera: Camera) -> None:
     current_camera.insert_point(0, 50, 50, 34, 1.5)
     current_camera.remove_point(0)
     assert len(list(current_camera.points)) == 0
+
+
+def test_camera_remove_point_wrong_index(current_camera: Camera) -> None:
+    current_camera.insert_point(0, 50, 50, 34, 1.5)
+    current_camera.remove_point(3)
+    assert len(current_camera.points_data) == 1
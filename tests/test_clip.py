@@ -11,6 +11,7 @@ from pytvpaint.clip import Clip
 from pytvpaint.george import RGBColor
 from pytvpaint.layer import Layer, LayerColor, LayerInstance
 from pytvpaint.project import Project
+from pytvpaint.render import render_incremental
 from pytvpaint.scene import Scene
 from tests.conftest import FixtureYield
 from tests.george.test_grg_clip import TEST_TEXTS
@@ -207,6 +208,47 @@ def test_clip_layers(test_clip_obj: Clip, create_some_layers: list[Layer]) -> No
     assert list(test_clip_obj.layers) == create_some_layers
 
 
+def test_clip_layers_snapshot(
+    test_clip_obj: Clip, create_some_layers: list[Layer]
+) -> None:
+    layers = test_clip_obj.layers_snapshot()
+    assert layers == create_some_layers
+    assert [layer.name for layer in layers] == [
+        layer.name for layer in create_some_layers
+    ]
+
+
+def test_clip_set_layers(
+    test_clip_obj: Clip, create_some_layers: list[Layer]
+) -> None:
+    hidden, shown = create_some_layers[:3], create_some_layers[3:]
+    color = LayerColor(3, test_clip_obj)
+
+    test_clip_obj.set_layers(hidden, is_visible=False, color=color)
+    test_clip_obj.set_layers([layer.id for layer in shown], is_locked=True)
+
+    assert [layer.is_visible for layer in create_some_layers] == [
+        False,
+        False,
+        False,
+        True,
+        True,
+    ]
+    assert all(layer.color == color for layer in hidden)
+    assert all(layer.is_locked for layer in shown)
+
+
+def test_clip_marks(test_clip_obj: Clip, create_some_layers: list[Layer]) -> None:
+    for layer in create_some_layers:
+        layer.convert_to_anim_layer()
+        layer.add_mark(layer.start, LayerColor(3, test_clip_obj))
+
+    assert list(test_clip_obj.marks) == [
+        (layer, layer.start, LayerColor(3, test_clip_obj))
+        for layer in create_some_layers
+    ]
+
+
 def test_clip_current_layer(test_clip_obj: Clip, test_layer_obj: Layer) -> None:
     assert test_clip_obj.current_layer == test_layer_obj
 
@@ -237,6 +279,18 @@ def test_clip_load_media(test_clip_obj: Clip, ppm_sequence: list[Path]) -> None:
     assert layer.name == "images"
 
 
+def test_clip_read_display(
+    test_clip_obj: Clip, count_up_generate: list[LayerInstance]
+) -> None:
+    project = test_clip_obj.project
+    image = test_clip_obj.read_display(test_clip_obj.start)
+    assert (image.width, image.height) == (project.width, project.height)
+
+    start = test_clip_obj.start
+    displays = test_clip_obj.read_displays(start, start + 2)
+    assert [frame for frame, _ in displays] == [start, start + 1, start + 2]
+
+
 @pytest.mark.parametrize(
     "out, start, end, expected",
     [
@@ -435,7 +489,11 @@ def test_clip_mark_out(
 
 
 def test_clip_layer_colors(test_clip_obj: Clip) -> None:
-    assert list(test_clip_obj.layer_colors)
+    colors = list(test_clip_obj.layer_colors)
+    assert colors == [LayerColor(i, test_clip_obj) for i in range(26)]
+    assert [c.name for c in colors] == [
+        LayerColor(i, test_clip_obj).name for i in range(26)
+    ]
 
 
 @pytest.fixture
@@ -516,3 +574,28 @@ def test_clip_go_to_next_bookmark(
 def test_clip_sounds(test_clip_obj: Clip, wav_file: Path) -> None:
     sound = test_clip_obj.add_sound(wav_file)
     assert list(test_clip_obj.sounds) == [sound]
+
+
+def test_clip_render_incremental(
+    test_clip_obj: Clip,
+    count_up_generate: None,
+    tmp_path: Path,
+) -> None:
+    out = tmp_path / "render.1-5#.png"
+    test_clip_obj.render(out, incremental=True)
+
+    file_sequence = FileSequence(out.as_posix())
+    assert file_sequence.frameSet() == FileSequence.findSequenceOnDisk(
+        out.as_posix(), strictPadding=True
+    ).frameSet()
+
+    # Nothing changed since the last render
+    assert render_incremental(test_clip_obj, out) == []
+
+    Path(file_sequence.frame(3)).unlink()
+    layer = test_clip_obj.get_layer(by_name="count_up")
+    assert layer
+    instance = layer.get_instance(1)
+    assert instance
+    instance.name = "renamed"
+    assert render_incremental(test_clip_obj, out) == [1, 3]
@@ -16,6 +16,15 @@ def test_clip_sound_remove(test_clip_sound: ClipSound) -> None:
         ClipSound(track_index=index)
 
 
+def test_clip_sound_adjust(test_clip_sound: ClipSound) -> None:
+    test_clip_sound.adjust(offset=2, volume=0.5, fade_in_stop=1)
+
+    assert test_clip_sound.offset == 2
+    assert test_clip_sound.volume == 0.5
+    assert test_clip_sound.fade_in_stop == 1
+    assert test_clip_sound.fade_out_stop == ClipSound(0).fade_out_stop
+
+
 @pytest.mark.skip("tv_sound_clip_reload doesn't work properly")
 def test_clip_sound_reload(test_clip_sound: ClipSound) -> None:
     test_clip_sound.reload()
@@ -0,0 +1,66 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from pytvpaint.image import RGBAImage, decode_tga, frame_dir, read_tga
+
+
+def tga_header(image_type: int, width: int, height: int, bits: int, desc: int) -> bytes:
+    return bytes(
+        [0, 0, image_type, 0, 0, 0, 0, 0, 0, 0, 0, 0]
+        + list(width.to_bytes(2, "little"))
+        + list(height.to_bytes(2, "little"))
+        + [bits, desc]
+    )
+
+
+def test_decode_tga_uncompressed_bottom_left() -> None:
+    # Bottom row first: blue, white then top row: red, green (BGRA)
+    pixels = bytes(
+        [255, 0, 0, 255, 255, 255, 255, 128]
+        + [0, 0, 255, 255, 0, 255, 0, 0]
+    )
+    image = decode_tga(tga_header(2, 2, 2, 32, 8) + pixels)
+
+    assert (image.width, image.height) == (2, 2)
+    assert image.pixel(0, 0) == (255, 0, 0, 255)
+    assert image.pixel(1, 0) == (0, 255, 0, 0)
+    assert image.pixel(0, 1) == (0, 0, 255, 255)
+    assert image.pixel(1, 1) == (255, 255, 255, 128)
+
+
+def test_decode_tga_rle_top_left() -> None:
+    # A run of 3 red pixels then a raw packet with a green pixel (BGR)
+    pixels = bytes([0x82, 0, 0, 255, 0x00, 0, 255, 0])
+    image = decode_tga(tga_header(10, 4, 1, 24, 0x20) + pixels)
+
+    assert image.data == bytes([255, 0, 0, 255] * 3 + [0, 255, 0, 255])
+
+
+def test_decode_tga_unsupported() -> None:
+    with pytest.raises(ValueError, match="Unsupported TGA image"):
+        decode_tga(tga_header(1, 1, 1, 8, 0) + bytes([0]))
+
+
+def test_image_pixels() -> None:
+    image = RGBAImage(3, 2, bytes(range(24)))
+    pixels = image.pixels
+    assert pixels.shape == (2, 3, 4)
+    assert pixels[1, 2, 3] == 23
+    assert pixels.readonly
+
+
+def test_read_tga(tmp_path: Path) -> None:
+    path = tmp_path / "image.tga"
+    path.write_bytes(tga_header(2, 1, 1, 24, 0x20) + bytes([1, 2, 3]))
+    assert read_tga(path) == RGBAImage(1, 1, bytes([3, 2, 1, 255]))
+
+
+def test_frame_dir(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setenv("PYTVPAINT_FRAME_DIR", str(tmp_path))
+    with frame_dir() as directory:
+        assert directory.parent == tmp_path
+        assert directory.is_dir()
+    assert not directory.exists()
@@ -7,6 +7,7 @@ import pytest
 from pytvpaint import george
 from pytvpaint.clip import Clip
 from pytvpaint.george import BlendingMode, StencilMode
+from pytvpaint.george.exceptions import NoObjectWithIdError
 from pytvpaint.george.grg_layer import (
     LayerBehavior,
     LayerTransparency,
@@ -23,6 +24,15 @@ def test_layer_init(test_layer_obj: Layer) -> None:
     assert Layer(test_layer_obj.id) == test_layer_obj
 
 
+def test_layer_init_wrong_id(test_clip_obj: Clip) -> None:
+    # The data is only fetched when it's read
+    layer = Layer(-1, clip=test_clip_obj)
+    assert layer.id == -1
+
+    with pytest.raises(NoObjectWithIdError):
+        Layer(-1, clip=test_clip_obj, validate=True)
+
+
 def test_layer_refresh(test_layer_obj: Layer) -> None:
     test_layer_obj.refresh()
 
@@ -58,6 +68,10 @@ def test_layer_name(test_layer_obj: Layer, name: str) -> None:
     assert test_layer_obj.name == name
 
 
+def test_layer_data(test_layer_obj: Layer) -> None:
+    assert test_layer_obj.data == george.tv_layer_info(test_layer_obj.id)
+
+
 @pytest.mark.parametrize("opacity", [1, 50, 24, 100])
 def test_layer_opacity(test_layer_obj: Layer, opacity: int) -> None:
     test_layer_obj.opacity = opacity
@@ -281,6 +295,18 @@ def test_layer_render_frame(with_loaded_sequence: Layer, tmp_path: Path) -> None
     with_loaded_sequence.render_frame(tmp_path / "out.jpg", frame=3)
 
 
+def test_layer_read_frames(with_loaded_sequence: Layer) -> None:
+    project = with_loaded_sequence.project
+    frames = list(with_loaded_sequence.read_frames(start=2, end=4))
+
+    assert [frame for frame, _ in frames] == [2, 3, 4]
+    for _, image in frames:
+        assert (image.width, image.height) == (project.width, project.height)
+        assert len(image.data) == image.width * image.height * 4
+
+    assert with_loaded_sequence.read_frame(3) == frames[1][1]
+
+
 def test_layer_add_mark_not_anim_layer(test_layer_obj: Layer) -> None:
     with pytest.raises(Exception, match="not an animation layer"):
         test_layer_obj.add_mark(0, LayerColor(1))
@@ -356,5 +382,38 @@ def test_layer_instances(
     assert real_instances == instances
 
 
+def test_layer_instance_starts(
+    test_project_obj: Project,
+    test_anim_layer_obj: Layer,
+    with_images: int,
+) -> None:
+    start_frame = test_project_obj.start_frame
+    starts = test_anim_layer_obj.instance_starts
+    assert starts == list(range(start_frame, start_frame + with_images))
+
+    # Breaking an instance invalidates the index
+    first_instance = test_anim_layer_obj.get_instance(start_frame)
+    assert first_instance
+    first_instance.length = 3
+    assert test_anim_layer_obj.instance_starts[:2] == [start_frame, start_frame + 3]
+
+
+def test_layer_retime(
+    test_project_obj: Project,
+    test_anim_layer_obj: Layer,
+    with_images: int,
+) -> None:
+    start_frame = test_project_obj.start_frame
+    starts = test_anim_layer_obj.instance_starts
+
+    instances = test_anim_layer_obj.retime((start, 2) for start in starts)
+    new_starts = list(range(start_frame, start_frame + with_images * 2, 2))
+    assert [instance.start for instance in instances] == new_starts
+    assert test_anim_layer_obj.instance_starts == new_starts
+
+    with pytest.raises(ValueError, match="no instance at frame"):
+        test_anim_layer_obj.retime([(start_frame + 1, 2)])
+
+
 def test_layer_rename_instances(test_anim_layer_obj: Layer, with_images: int) -> None:
     test_anim_layer_obj.rename_instances(george.InstanceNamingMode.ALL, prefix="hello_")
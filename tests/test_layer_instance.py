@@ -19,8 +19,11 @@ def test_layer_instance_init(test_anim_layer_obj: Layer) -> None:
 
 
 def test_layer_instance_init_wrong_frame(test_anim_layer_obj: Layer) -> None:
+    # Handles are not checked by default
+    LayerInstance(test_anim_layer_obj, 67)
+
     with pytest.raises(ValueError, match="no instance at frame"):
-        LayerInstance(test_anim_layer_obj, 67)
+        LayerInstance(test_anim_layer_obj, 67, validate=True)
 
 
 @pytest.mark.parametrize("name", ["name", "l", "lo6", "8.2"])
@@ -0,0 +1,215 @@
+"""Benchmarks of the object API against the mock TVPaint server, run them with `pytest -s` to see the timings.
+
+The number of requests sent to TVPaint is checked too, a change means that a George call was added or removed.
+"""
+
+from __future__ import annotations
+
+from typing import Any, Callable
+
+import pytest
+
+import pytvpaint
+from pytvpaint import george, utils
+from pytvpaint.clip import Clip
+from pytvpaint.layer import Layer
+from pytvpaint.project import Project
+from pytvpaint.query import color, visible
+from tests.conftest import Benchmark, FixtureYield
+from tests.mock_server import MockTVPaint, respond_clip
+
+LAYER_COUNT = 150
+SOUNDS_INFO = [
+    f'{track}.5 1.0 0 0.0 0.5 9.0 10.0 "sounds/track {track}.wav" 0.0 10.0 {track}'
+    for track in range(20)
+]
+
+
+@pytest.fixture
+def mock_clip(mock_tvpaint: MockTVPaint) -> FixtureYield[Clip]:
+    respond_clip(mock_tvpaint, layer_count=LAYER_COUNT, frame_count=100)
+    yield Clip(1, Project("7"))
+
+
+def count_requests(
+    server: MockTVPaint, benchmark: Benchmark, func: Callable[[], Any]
+) -> int:
+    """Run the function once and count its requests, they are stored with the benchmark results."""
+    server.reset_stats()
+    func()
+    benchmark.extra_info["rpc_count"] = server.requests
+    return server.requests
+
+
+def test_benchmark_clip_layers(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    def get_layers() -> list[Layer]:
+        return list(mock_clip.layers)
+
+    # The current clip, then the id of each layer until there's no layer left
+    assert count_requests(mock_tvpaint, benchmark, get_layers) == LAYER_COUNT + 2
+    assert len(benchmark(get_layers)) == LAYER_COUNT
+
+
+def test_benchmark_clip_layers_snapshot(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    assert count_requests(mock_tvpaint, benchmark, mock_clip.layers_snapshot) == 1
+    assert len(benchmark(mock_clip.layers_snapshot)) == LAYER_COUNT
+
+
+def test_benchmark_project_query(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    info = '"layer_{0}" SEQUENCE 0 99 0 0 0 1 OFF'
+    mock_tvpaint.respond_script(
+        "tv_LayerInfo layer_id",
+        ["clip 1 1 shot_010"]
+        + [
+            f"{100 + pos} {pos % 4} ON {pos} 100 " + info.format(pos)
+            for pos in range(LAYER_COUNT)
+        ],
+    )
+
+    def find_layers() -> list[int]:
+        with pytvpaint.cached():
+            query = mock_clip.project.query
+            layers = query.layers(where=visible & (color == 1), clip=mock_clip)
+            found = [query.layer(by_name=f"layer_{pos}") for pos in range(0, 150, 3)]
+            return [layer.id for layer in layers + found if layer]
+
+    # The current project, then the whole project is fetched once for all the lookups
+    assert count_requests(mock_tvpaint, benchmark, find_layers) == 2
+    assert len(benchmark(find_layers)) == len(range(1, LAYER_COUNT, 4)) + 50
+
+
+def test_benchmark_layer_instances(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    layer = Layer(100, mock_clip)
+
+    def get_instances() -> list[int]:
+        return [instance.start for instance in layer.instances]
+
+    assert count_requests(mock_tvpaint, benchmark, get_instances) == 5
+    assert len(benchmark(get_instances)) == 50
+
+
+def test_benchmark_layer_instance_ends(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    layer = Layer(100, mock_clip)
+
+    def get_ends() -> list[int]:
+        return [instance.end for instance in layer.instances]
+
+    # Outside of a cached context the layer info is read again for each instance, but
+    # the instances keep the index they were found in
+    count_requests(mock_tvpaint, benchmark, get_ends)
+    scripts = [c for c in mock_tvpaint.commands if c.startswith("tv_RunScript")]
+    assert len(scripts) == 1
+
+    # The index isn't kept once the instances are gone, it may be changed in the UI
+    mock_tvpaint.reset_stats()
+    assert layer.get_instance(0)
+    assert any(c.startswith("tv_RunScript") for c in mock_tvpaint.commands)
+    assert len(benchmark(get_ends)) == 50
+
+
+def test_benchmark_layer_retime(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    layer = Layer(100, mock_clip)
+    timings = [(start, 3) for start in layer.instance_starts]
+    sources: list[str] = []
+
+    def exposures_set(source: str) -> list[str]:
+        sources.append(source)
+        return []
+
+    mock_tvpaint.respond_script("tv_ExposureSet", exposures_set)
+
+    def retime() -> list[int]:
+        return [instance.start for instance in layer.retime(timings)]
+
+    # The instances index, then all the exposures are set in one script
+    assert count_requests(mock_tvpaint, benchmark, retime) == 9
+    assert benchmark(retime)[:3] == [0, 3, 6]
+    assert sources[-1].count("tv_ExposureSet") == 50
+
+
+def test_benchmark_layer_marks(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    layer = Layer(100, mock_clip)
+
+    def get_marks() -> list[int]:
+        return [frame for frame, color in layer.marks if color.index == 1]
+
+    # The colors of the marks are read in a single script, whatever their number
+    assert count_requests(mock_tvpaint, benchmark, get_marks) == 10
+    assert len(benchmark(get_marks)) == 10
+
+
+def test_benchmark_clip_sounds(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    mock_tvpaint.respond_script("tv_SoundClipInfo", SOUNDS_INFO)
+
+    def read_sounds() -> list[tuple[float, float, float]]:
+        with pytvpaint.cached():
+            return [(s.offset, s.volume, s.fade_in_stop) for s in mock_clip.sounds]
+
+    # The info of all the tracks is fetched once
+    assert count_requests(mock_tvpaint, benchmark, read_sounds) == 1
+    assert len(benchmark(read_sounds)) == len(SOUNDS_INFO)
+
+
+def test_benchmark_sound_property(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    mock_tvpaint.respond_script("tv_SoundClipInfo", SOUNDS_INFO)
+    sound = list(mock_clip.sounds)[-1]
+
+    def read_offset() -> float:
+        return sound.offset
+
+    # Outside of cached(), the info of all the tracks is fetched once per read
+    assert count_requests(mock_tvpaint, benchmark, read_offset) == 1
+    assert benchmark(read_offset) == 19.5
+
+
+def test_benchmark_sound_adjust(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    mock_tvpaint.respond_script("tv_SoundClipInfo", SOUNDS_INFO)
+    sound = list(mock_clip.sounds)[-1]
+
+    def adjust_sound() -> None:
+        sound.adjust(offset=2, volume=0.5, fade_in_stop=1)
+
+    # The current clip, the info of all the tracks and the adjust
+    assert count_requests(mock_tvpaint, benchmark, adjust_sound) == 3
+    adjust_cmd = "tv_SoundClipAdjust 19 0 0.5 2 0.0 1 9.0 10.0 19"
+    assert mock_tvpaint.commands[-1] == adjust_cmd
+    benchmark(adjust_sound)
+
+
+def test_benchmark_render_context(
+    mock_tvpaint: MockTVPaint, mock_clip: Clip, benchmark: Benchmark
+) -> None:
+    selection = [Layer(100, mock_clip)]
+
+    def enter_render_context() -> None:
+        with utils.render_context(
+            george.AlphaSaveMode.NO_ALPHA,
+            save_format=george.SaveFormat.JPG,
+            layer_selection=selection,
+        ):
+            pass
+
+    # Read the current settings and layers, apply the changes and restore them in batches,
+    # the current clip is read again to restore the layers of each changed clip
+    assert count_requests(mock_tvpaint, benchmark, enter_render_context) == 8
+    benchmark(enter_render_context)
@@ -5,7 +5,7 @@ import pytest
 from pytvpaint import george
 from pytvpaint.clip import Clip
 from pytvpaint.george.grg_project import TVPProject
-from pytvpaint.project import Project
+from pytvpaint.project import Project, ProjectIndex
 from pytvpaint.scene import Scene
 from pytvpaint.sound import ProjectSound
 from tests.conftest import FixtureYield
@@ -310,6 +310,28 @@ def test_project_clips(
     assert list(test_project_obj.clips) == clips
 
 
+def test_project_index(
+    test_project_obj: Project, create_some_clips: list[Clip]
+) -> None:
+    index = test_project_obj.index
+    assert index.clip_ids == [clip.id for clip in test_project_obj.clips]
+    for scene in test_project_obj.scenes:
+        for position, clip_id in enumerate(scene.clip_ids):
+            assert index.clip_scene_id(clip_id) == scene.id
+            assert index.clip_position(clip_id) == position
+
+
+def test_project_index_lookup() -> None:
+    index = ProjectIndex([(1, [10, 11]), (2, []), (3, [12])])
+    assert index.scene_ids == [1, 2, 3]
+    assert index.clip_ids == [10, 11, 12]
+    assert index.clip_scene_id(12) == 3
+    assert index.clip_position(11) == 1
+    assert not index.has_clip(13)
+    with pytest.raises(ValueError):
+        index.clip_position(13)
+
+
 def test_project_get_clip_by_id(test_project_obj: Project, test_clip_obj: Clip) -> None:
     assert test_project_obj.get_clip(by_id=test_clip_obj.id) == test_clip_obj
 
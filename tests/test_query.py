@@ -0,0 +1,116 @@
+from __future__ import annotations
+
+import dataclasses
+
+import pytest
+
+import pytvpaint
+from pytvpaint import george
+from pytvpaint.project import Project
+from pytvpaint.query import (
+    LayerRecord,
+    ProjectQuery,
+    anim,
+    color,
+    name,
+    position,
+    visible,
+)
+from tests.mock_server import MockTVPaint, respond_clip
+
+
+def layer_info(layer_id: int, name: str = "layer", pos: int = 0) -> george.TVPLayer:
+    return george.TVPLayer(
+        id=layer_id,
+        visibility=True,
+        position=pos,
+        density=100,
+        name=name,
+        type=george.LayerType.SEQUENCE,
+        first_frame=0,
+        last_frame=9,
+        selected=False,
+        editable=True,
+        stencil_state=george.StencilMode.OFF,
+    )
+
+
+@pytest.fixture
+def query() -> ProjectQuery:
+    char = layer_info(10, "char")
+    hidden = dataclasses.replace(layer_info(11, "BG", 1), visibility=False)
+    image = dataclasses.replace(layer_info(20, "bg"), type=george.LayerType.IMAGE)
+    return ProjectQuery(
+        Project("7"),
+        [
+            george.TVPClipLayers(1, 1, "shot_010", [char, hidden], [3, 0]),
+            george.TVPClipLayers(1, 2, "Shot_020", [image], [3]),
+            george.TVPClipLayers(2, 3, "shot_010", [], []),
+        ],
+    )
+
+
+def test_predicates() -> None:
+    record = LayerRecord(1, layer_info(10, "char_main", 2), 3)
+
+    assert (visible & anim & (color == 3))(record)
+    assert not (visible & (color != 3))(record)
+    assert (~visible | (position >= 2))(record)
+    assert name.matches("^char_")(record)
+    assert color.isin([1, 3])(record)
+    assert not (position < 2)(record)
+
+
+def test_project_query_records(query: ProjectQuery) -> None:
+    assert [r.id for r in query.records()] == [10, 11, 20]
+    assert [r.id for r in query.records(where=visible & (color == 3))] == [10, 20]
+    assert [r.id for r in query.records(where=anim, clip=1)] == [10, 11]
+    assert query.records(where=~visible, clip=2) == []
+
+
+def test_project_query_names(query: ProjectQuery) -> None:
+    assert query.clip_names == ["shot_010", "Shot_020", "shot_010"]
+    assert query.clip_ids("SHOT_010") == [1, 3]
+    assert query.clip_ids("shot_010", scene_id=2) == [3]
+    assert query.clip_name(2) == "Shot_020"
+    assert query.clip_name(4) is None
+    assert query.layer_names(1) == ["char", "BG"]
+    assert query.unique_layer_name(1, "char") == "char2"
+
+
+def test_project_query_layer(query: ProjectQuery) -> None:
+    layer = query.layer(by_name="bg")
+    assert layer and layer.id == 11
+
+    layer = query.layer(by_name="bg", clip=2)
+    assert layer and layer.id == 20
+    assert query.layer(by_id=10, by_name="bg") is None
+    assert query.layer(by_id=99) is None
+
+    with pytest.raises(ValueError):
+        query.layer()
+
+
+def test_project_query_lookups(mock_tvpaint: MockTVPaint) -> None:
+    layer_ids = respond_clip(mock_tvpaint, layer_count=3, frame_count=10)
+    info = 'ON 0 100 "layer" SEQUENCE 0 9 0 0 0 1 OFF'
+    mock_tvpaint.respond_script("line = scene_id", ["5 1 2"])
+    mock_tvpaint.respond_script("tv_ClipName clip_id", ["5 1 shot 010", "5 2 other"])
+    mock_tvpaint.respond_script(
+        "tv_LayerInfo layer_id",
+        ["clip 5 1 shot 010", *(f"{i} 2 {info}" for i in layer_ids), "clip 5 2 other"],
+    )
+    project = Project("7")
+
+    with pytvpaint.cached():
+        mock_tvpaint.reset_stats()
+        clip = project.get_clip(by_name="shot 010")
+        assert clip and clip.id == 1
+        assert list(project.clip_names) == ["shot 010", "other"]
+        # The current project, the scenes index and the clip names, not the query
+        assert mock_tvpaint.requests == 3
+
+        layers = project.query.layers(where=color == 2)
+        assert [layer.id for layer in layers] == layer_ids
+        assert project.query.layer(by_name="layer")
+        assert mock_tvpaint.requests == 4
@@ -0,0 +1,449 @@
+from __future__ import annotations
+
+import threading
+from concurrent.futures import Future
+from pathlib import Path
+from typing import Any
+
+import pytest
+from fileseq.filesequence import FileSequence
+
+from pytvpaint import george, render
+from pytvpaint.clip import Clip
+from pytvpaint.george.client import create_client, get_client, send_cmd
+from pytvpaint.george.client.rpc import JSONRPCClient
+from pytvpaint.project import Project
+from pytvpaint.render import (
+    RenderDispatcher,
+    RenderManifest,
+    StructureExport,
+    StructureFormat,
+    export_structures,
+    frame_runs,
+    split_file_sequence,
+    structure_path,
+    verify_structure,
+)
+from tests.conftest import FixtureYield
+from tests.mock_server import MockTVPaint, respond_clip
+
+
+@pytest.mark.parametrize(
+    "chunk_size, expected",
+    [
+        (3, ["1-3", "4-6", "7-9", "10"]),
+        (5, ["1-5", "6-10"]),
+        (20, ["1-10"]),
+    ],
+)
+def test_split_file_sequence(chunk_size: int, expected: list[str]) -> None:
+    file_sequence = FileSequence("out/image.1-10#.png")
+    chunks = split_file_sequence(file_sequence, chunk_size)
+
+    assert [str(chunk.frameSet()) for chunk in chunks] == expected
+    assert all(chunk.basename() == "image." for chunk in chunks)
+
+
+def test_split_file_sequence_wrong_chunk_size() -> None:
+    with pytest.raises(ValueError, match="Chunk size"):
+        split_file_sequence(FileSequence("out/image.1-10#.png"), 0)
+
+
+def test_split_file_sequence_no_range() -> None:
+    with pytest.raises(ValueError, match="no frame range"):
+        split_file_sequence(FileSequence("out/image.png"), 2)
+
+
+@pytest.mark.parametrize(
+    "frames, expected",
+    [
+        ([], []),
+        ([3], [(3, 3)]),
+        ([5, 1, 2, 3, 7, 8], [(1, 3), (5, 5), (7, 8)]),
+    ],
+)
+def test_frame_runs(frames: list[int], expected: list[tuple[int, int]]) -> None:
+    assert frame_runs(frames) == expected
+
+
+def test_render_manifest_path() -> None:
+    path = RenderManifest.path_for(FileSequence("out/shot.1-10#.png"))
+    assert path == Path("out", "shot.manifest.json")
+
+
+def test_render_manifest(tmp_path: Path) -> None:
+    file_sequence = FileSequence((tmp_path / "image.1-3#.png").as_posix())
+    manifest = RenderManifest(RenderManifest.path_for(file_sequence), "settings")
+    manifest.frames = {1: "a", 2: "b", 3: "c"}
+    manifest.save()
+
+    for frame in (1, 2):
+        Path(file_sequence.frame(frame)).touch()
+
+    loaded = RenderManifest.load(manifest.path)
+    assert loaded == manifest
+
+    frames = {1: "a", 2: "changed", 3: "c"}
+    assert loaded.outdated_frames("settings", frames, file_sequence) == [2, 3]
+    assert loaded.outdated_frames("other", frames, file_sequence) == [1, 2, 3]
+
+
+def test_render_manifest_missing(tmp_path: Path) -> None:
+    manifest = RenderManifest.load(tmp_path / "missing.json")
+    assert (manifest.settings, manifest.frames) == ("", {})
+
+
+@pytest.mark.parametrize(
+    "structure_format, expected",
+    [
+        (StructureFormat.JSON, "out/shot/json/shot.json"),
+        (StructureFormat.PSD, "out/shot/psd/shot.psd"),
+        (StructureFormat.CSV, "out/shot/csv/shot.csv"),
+        (StructureFormat.SPRITES, "out/shot/sprites/shot.jpg"),
+        (StructureFormat.FLIX, "out/shot/flix/shot.xml"),
+    ],
+)
+def test_structure_path(structure_format: StructureFormat, expected: str) -> None:
+    path = structure_path("out", "shot", structure_format, george.SaveFormat.JPG)
+    assert path == Path(expected)
+
+
+def test_verify_structure(tmp_path: Path) -> None:
+    export_path = structure_path(tmp_path, "shot", StructureFormat.JSON)
+    export_path.parent.mkdir(parents=True)
+    export_path.write_text('{"project": {}}')
+    image = export_path.parent / "shot" / "layer.png"
+    image.parent.mkdir()
+    image.write_bytes(b"png")
+
+    export = verify_structure("shot", StructureFormat.JSON, export_path)
+    assert export.clip_name == "shot"
+    assert export.files == sorted([export_path, image])
+
+
+def test_verify_structure_invalid(tmp_path: Path) -> None:
+    export_path = structure_path(tmp_path, "shot", StructureFormat.JSON)
+    with pytest.raises(FileNotFoundError):
+        verify_structure("shot", StructureFormat.JSON, export_path)
+
+    export_path.parent.mkdir(parents=True)
+    export_path.write_text('{"project": ')
+    with pytest.raises(ValueError, match="Invalid JSON"):
+        verify_structure("shot", StructureFormat.JSON, export_path)
+
+    export_path.write_text("{}")
+    with pytest.raises(FileNotFoundError, match="No images"):
+        verify_structure("shot", StructureFormat.JSON, export_path)
+
+    csv_path = structure_path(tmp_path, "shot", StructureFormat.CSV)
+    csv_path.parent.mkdir(parents=True)
+    csv_path.write_text("\n")
+    with pytest.raises(ValueError, match="Empty CSV"):
+        verify_structure("shot", StructureFormat.CSV, csv_path)
+
+
+class StubClip:
+    """Stands for the clip each instance loads, its renders are sent to the instance's client.
+
+    The renders wait for each other at a barrier, so that each render runs on its own instance.
+    """
+
+    def __init__(self, name: str, barrier: threading.Barrier) -> None:
+        self.name = name
+        self.start = 1
+        self.end = 10
+        self.mark_in: int | None = None
+        self.mark_out: int | None = None
+        self.barrier = barrier
+
+    def render(
+        self,
+        output_path: FileSequence | Path | str,
+        start: int | None = None,
+        end: int | None = None,
+        **render_options: Any,
+    ) -> None:
+        send_cmd("tv_ProjectSaveSequence", str(output_path), start, end)
+        self.barrier.wait(timeout=5)
+        if self.name == "broken":
+            raise ValueError(f"Can't render {self.name}")
+        for frame in range(start or self.start, (end or self.end) + 1):
+            Path(FileSequence(str(output_path)).frame(frame)).touch()
+
+
+RENDER_SETTINGS = {
+    "tv_SaveMode": "png",
+    "tv_AlphaSaveMode": "premultiply",
+    "tv_Background": "none",
+}
+
+
+@pytest.fixture
+def mock_instances() -> FixtureYield[list[MockTVPaint]]:
+    with MockTVPaint(RENDER_SETTINGS) as first, MockTVPaint(RENDER_SETTINGS) as second:
+        yield [first, second]
+
+
+@pytest.fixture
+def dispatcher(mock_instances: list[MockTVPaint]) -> FixtureYield[RenderDispatcher]:
+    clients = [
+        create_client("ws://127.0.0.1", server.port, timeout=5)
+        for server in mock_instances
+    ]
+    with RenderDispatcher(clients) as render_dispatcher:
+        yield render_dispatcher
+
+
+def stub_clips(
+    monkeypatch: pytest.MonkeyPatch, names: list[str], parties: int
+) -> dict[str, StubClip]:
+    barrier = threading.Barrier(parties)
+    clips = {name: StubClip(name, barrier) for name in names}
+    monkeypatch.setattr(
+        RenderDispatcher,
+        "_load_clip",
+        staticmethod(lambda project_path, clip_name: clips[clip_name]),
+    )
+    return clips
+
+
+def render_commands(server: MockTVPaint) -> list[str]:
+    return [
+        cmd for cmd in server.commands if cmd.startswith("tv_ProjectSaveSequence")
+    ]
+
+
+def test_render_dispatcher_render_clip(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    mock_instances: list[MockTVPaint],
+    dispatcher: RenderDispatcher,
+) -> None:
+    stub_clips(monkeypatch, ["shot"], parties=2)
+    output = FileSequence((tmp_path / "shot.#.png").as_posix())
+
+    result = dispatcher.render_clip("shot.tvpp", "shot", output)
+
+    # The frames are split evenly, each instance renders one of the chunks
+    assert str(result.frameSet()) == "1-10"
+    commands = [render_commands(server) for server in mock_instances]
+    assert all(len(cmds) == 1 for cmds in commands)
+    ranges = sorted(cmd.split()[-2:] for cmds in commands for cmd in cmds)
+    assert ranges == [["1", "5"], ["6", "10"]]
+
+
+def test_render_dispatcher_render_clips(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    mock_instances: list[MockTVPaint],
+    dispatcher: RenderDispatcher,
+) -> None:
+    stub_clips(monkeypatch, ["shot_1", "shot_2"], parties=2)
+    outputs = {name: tmp_path / f"{name}.1-10#.png" for name in ("shot_1", "shot_2")}
+
+    dispatcher.render_clips("shot.tvpp", outputs)
+
+    # Each clip is rendered by its own instance
+    commands = [render_commands(server) for server in mock_instances]
+    assert all(len(cmds) == 1 for cmds in commands)
+    assert len(list(tmp_path.glob("*.png"))) == 20
+
+
+def test_render_dispatcher_acquire_client(dispatcher: RenderDispatcher) -> None:
+    with dispatcher._acquire_client() as first:
+        assert get_client() is first
+        with dispatcher._acquire_client() as second:
+            assert second is not first
+            assert get_client() is second
+            assert dispatcher._available.empty()
+        assert get_client() is first
+
+    with pytest.raises(ValueError), dispatcher._acquire_client():
+        raise ValueError("Render failed")
+
+    # The clients are back in the pool, even after an error
+    assert dispatcher._available.qsize() == len(dispatcher.clients)
+
+
+def test_render_dispatcher_wait_raises_first_error() -> None:
+    futures: list[Future[None]] = [Future() for _ in range(3)]
+    futures[0].set_result(None)
+    futures[1].set_exception(ValueError("first"))
+    futures[2].set_exception(RuntimeError("second"))
+
+    with pytest.raises(ValueError, match="first"):
+        RenderDispatcher._wait(futures)
+
+
+def test_render_dispatcher_render_clips_error(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    dispatcher: RenderDispatcher,
+) -> None:
+    stub_clips(monkeypatch, ["broken", "shot"], parties=2)
+    outputs = {name: tmp_path / f"{name}.1-10#.png" for name in ("broken", "shot")}
+
+    with pytest.raises(ValueError, match="Can't render broken"):
+        dispatcher.render_clips("shot.tvpp", outputs)
+
+    # The other clip is still rendered and the clients are back in the pool
+    assert len(list(tmp_path.glob("shot.*.png"))) == 10
+    assert dispatcher._available.qsize() == len(dispatcher.clients)
+
+
+StructureWrite = tuple[JSONRPCClient, str, StructureFormat]
+
+
+@pytest.fixture
+def structure_writes(monkeypatch: pytest.MonkeyPatch) -> list[StructureWrite]:
+    """Write the exports like TVPaint, the JSON export of "empty" has no images."""
+    writes: list[StructureWrite] = []
+
+    def write_structure(
+        clip: Clip,
+        structure_format: StructureFormat,
+        export_path: Path,
+        save_format: george.SaveFormat = george.SaveFormat.PNG,
+    ) -> None:
+        writes.append((get_client(), clip.name, structure_format))
+        export_path.parent.mkdir(exist_ok=True, parents=True)
+        if structure_format != StructureFormat.JSON:
+            export_path.write_bytes(b"structure")
+            return
+
+        export_path.write_text('{"project": {}}')
+        if clip.name != "empty":
+            image = export_path.parent / clip.name / "layer.png"
+            image.parent.mkdir()
+            image.write_bytes(b"png")
+
+    monkeypatch.setattr(render, "export_structure", write_structure)
+    return writes
+
+
+@pytest.fixture
+def project_clips(mock_tvpaint: MockTVPaint) -> list[Clip]:
+    respond_clip(mock_tvpaint)
+    mock_tvpaint.respond("tv_ClipName", lambda args: f"shot_{args[0]}")
+    mock_tvpaint.respond(
+        "tv_ProjectInfo", '"/projects/shot.tvpp" 1920 1080 1.0 24.0 none 0'
+    )
+    project = Project("7")
+    return [Clip(1, project), Clip(2, project)]
+
+
+STRUCTURE_FORMATS = [StructureFormat.JSON, StructureFormat.PSD]
+
+
+def exported(exports: list[StructureExport]) -> list[tuple[str, StructureFormat]]:
+    return [(export.clip_name, export.format) for export in exports]
+
+
+def test_export_structures(
+    tmp_path: Path, structure_writes: list[StructureWrite], project_clips: list[Clip]
+) -> None:
+    exports = export_structures(project_clips, tmp_path, STRUCTURE_FORMATS)
+
+    assert exported(exports) == [
+        ("shot_1", StructureFormat.JSON),
+        ("shot_1", StructureFormat.PSD),
+        ("shot_2", StructureFormat.JSON),
+        ("shot_2", StructureFormat.PSD),
+    ]
+    json_path = structure_path(tmp_path, "shot_1", StructureFormat.JSON)
+    image = json_path.parent / "shot_1" / "layer.png"
+    assert exports[0].files == sorted([json_path, image])
+    psd_path = structure_path(tmp_path, "shot_1", StructureFormat.PSD)
+    assert exports[1].files == [psd_path]
+
+
+def test_export_structures_invalid(
+    tmp_path: Path,
+    mock_tvpaint: MockTVPaint,
+    structure_writes: list[StructureWrite],
+    project_clips: list[Clip],
+) -> None:
+    mock_tvpaint.respond("tv_ClipName", "empty")
+
+    # The error of the verification is raised once TVPaint exported everything
+    with pytest.raises(FileNotFoundError, match="No images"):
+        export_structures(project_clips, tmp_path, STRUCTURE_FORMATS)
+    assert len(structure_writes) == 4
+
+
+def test_project_export_structures(
+    tmp_path: Path, structure_writes: list[StructureWrite], project_clips: list[Clip]
+) -> None:
+    project = project_clips[0].project
+    exports = project.export_structures(tmp_path, STRUCTURE_FORMATS, project_clips)
+
+    assert exported(exports) == [
+        ("shot_1", StructureFormat.JSON),
+        ("shot_1", StructureFormat.PSD),
+        ("shot_2", StructureFormat.JSON),
+        ("shot_2", StructureFormat.PSD),
+    ]
+
+
+def test_render_dispatcher_export_structures(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    dispatcher: RenderDispatcher,
+    structure_writes: list[StructureWrite],
+) -> None:
+    stub_clips(monkeypatch, ["shot_1", "shot_2"], parties=1)
+
+    exports = dispatcher.export_structures(
+        "shot.tvpp", tmp_path, STRUCTURE_FORMATS, ["shot_1", "shot_2"]
+    )
+
+    assert exported(exports) == [
+        ("shot_1", StructureFormat.JSON),
+        ("shot_1", StructureFormat.PSD),
+        ("shot_2", StructureFormat.JSON),
+        ("shot_2", StructureFormat.PSD),
+    ]
+    assert all(client in dispatcher.clients for client, _, _ in structure_writes)
+
+
+def test_render_dispatcher_export_structures_invalid(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    dispatcher: RenderDispatcher,
+    structure_writes: list[StructureWrite],
+) -> None:
+    stub_clips(monkeypatch, ["empty", "shot"], parties=1)
+
+    with pytest.raises(FileNotFoundError, match="No images"):
+        dispatcher.export_structures(
+            "shot.tvpp", tmp_path, STRUCTURE_FORMATS, ["empty", "shot"]
+        )
+    assert dispatcher._available.qsize() == len(dispatcher.clients)
+
+
+def test_project_export_structures_dispatcher(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+    dispatcher: RenderDispatcher,
+    structure_writes: list[StructureWrite],
+    project_clips: list[Clip],
+) -> None:
+    stub_clips(monkeypatch, ["shot_1", "shot_2"], parties=1)
+    loaded: list[Path] = []
+    load_clip = RenderDispatcher._load_clip
+
+    def record_load(project_path: Path, clip_name: str) -> Clip:
+        loaded.append(project_path)
+        return load_clip(project_path, clip_name)
+
+    monkeypatch.setattr(RenderDispatcher, "_load_clip", staticmethod(record_load))
+
+    project = project_clips[0].project
+    exports = project.export_structures(
+        tmp_path, STRUCTURE_FORMATS, project_clips, dispatcher=dispatcher
+    )
+
+    # The instances load the project from its saved file
+    assert loaded == [Path("/projects/shot.tvpp")] * 2
+    assert [export.clip_name for export in exports] == ["shot_1"] * 2 + ["shot_2"] * 2
+    assert all(client in dispatcher.clients for client, _, _ in structure_writes)
@@ -2,7 +2,17 @@ from __future__ import annotations
 
 import pytest
 
-from pytvpaint.utils import get_unique_name
+from pytvpaint import george
+from pytvpaint.clip import Clip
+from pytvpaint.george.client.rpc import JSONRPCResponseError
+from pytvpaint.layer import Layer
+from pytvpaint.utils import (
+    RenderState,
+    get_unique_name,
+    render_context,
+    render_session,
+)
+from tests.mock_server import MockTVPaint
 
 
 @pytest.mark.parametrize(
@@ -23,3 +33,80 @@ from pytvpaint.utils import get_unique_name
 def test_get_unique_name(test_case: tuple[list[str], str, str]) -> None:
     current_names, name, expected = test_case
     assert get_unique_name(current_names, name) == expected
+
+
+def test_render_context(test_clip_obj: Clip, create_some_layers: list[Layer]) -> None:
+    state = RenderState.current()
+    visible_layer = create_some_layers[0]
+
+    with render_context(
+        alpha_mode=george.AlphaSaveMode.NO_ALPHA,
+        save_format=george.SaveFormat.PNG,
+        layer_selection=[visible_layer],
+    ):
+        assert george.tv_alpha_save_mode_get() == george.AlphaSaveMode.NO_ALPHA
+        assert [layer.is_visible for layer in create_some_layers] == [
+            layer == visible_layer for layer in create_some_layers
+        ]
+
+    assert RenderState.current() == state
+    assert all(layer.is_visible for layer in create_some_layers)
+
+
+def test_render_session(test_clip_obj: Clip, create_some_layers: list[Layer]) -> None:
+    state = RenderState.current()
+
+    with render_session() as session:
+        for layer in create_some_layers:
+            with render_context(
+                alpha_mode=george.AlphaSaveMode.NO_ALPHA, layer_selection=[layer]
+            ):
+                assert layer.is_visible
+
+        # The state is restored once at the end of the session
+        assert session.applied.alpha_mode == george.AlphaSaveMode.NO_ALPHA
+        assert george.tv_alpha_save_mode_get() == george.AlphaSaveMode.NO_ALPHA
+
+    assert RenderState.current() == state
+    assert all(layer.is_visible for layer in create_some_layers)
+
+
+def test_render_session_clips(create_some_clips: list[Clip]) -> None:
+    first, second = create_some_clips[:2]
+    layers = {
+        clip: [clip.add_layer("a"), clip.add_layer("b")] for clip in (first, second)
+    }
+
+    with render_session():
+        for clip, (shown, hidden) in layers.items():
+            clip.make_current()
+            with render_context(layer_selection=[shown]):
+                assert not hidden.is_visible
+
+    # The layers of each clip are restored, not only the ones of the current clip
+    assert second.is_current
+    for clip_layers in layers.values():
+        assert all(layer.is_visible for layer in clip_layers)
+
+
+def test_render_session_restore_error(mock_tvpaint: MockTVPaint) -> None:
+    def alpha_save_mode(args: list[str]) -> str:
+        if args == ["premultiply"]:
+            raise ValueError("Can't restore the alpha mode")
+        return "premultiply"
+
+    mock_tvpaint.respond("tv_AlphaSaveMode", alpha_save_mode)
+    mock_tvpaint.respond("tv_SaveMode", "png")
+    mock_tvpaint.respond("tv_Background", "none")
+
+    # The error of the render isn't hidden by the one of the restore
+    with pytest.raises(RuntimeError, match="Render failed"):
+        with render_session() as session:
+            session.apply(alpha_mode=george.AlphaSaveMode.NO_ALPHA)
+            raise RuntimeError("Render failed")
+    assert session.applied == session.original
+
+    with pytest.raises(JSONRPCResponseError, match="Can't restore"):
+        with render_session() as session:
+            session.apply(alpha_mode=george.AlphaSaveMode.NO_ALPHA)
+    assert session.applied == session.original
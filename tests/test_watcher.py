@@ -0,0 +1,155 @@
+from __future__ import annotations
+
+import dataclasses
+import re
+
+from pytvpaint import george
+from pytvpaint.project import Project
+from pytvpaint.watcher import (
+    ChangeKind,
+    ClipState,
+    LayerState,
+    ProjectState,
+    ProjectWatcher,
+    diff_states,
+)
+from tests.mock_server import MockTVPaint, respond_clip
+
+
+def layer_state(
+    layer_id: int, name: str = "layer", starts: tuple[int, ...] = (0,)
+) -> LayerState:
+    info = george.TVPLayer(
+        id=layer_id,
+        visibility=True,
+        position=0,
+        density=100,
+        name=name,
+        type=george.LayerType.SEQUENCE,
+        first_frame=0,
+        last_frame=9,
+        selected=False,
+        editable=True,
+        stencil_state=george.StencilMode.OFF,
+    )
+    return LayerState(1, info, starts)
+
+
+def test_diff_states_first_poll() -> None:
+    after: ProjectState = {
+        1: ClipState("shot_1", {10: layer_state(10)}),
+        2: ClipState("shot_2"),
+    }
+    changes = diff_states({}, after)
+    assert [(c.kind, c.clip_id, c.layer_id, c.clip_name) for c in changes] == [
+        (ChangeKind.CLIP_ADDED, 1, None, "shot_1"),
+        (ChangeKind.LAYER_ADDED, 1, 10, "shot_1"),
+        (ChangeKind.CLIP_ADDED, 2, None, "shot_2"),
+    ]
+
+
+def test_diff_states_unchanged() -> None:
+    state: ProjectState = {
+        1: ClipState("shot", {10: layer_state(10), 11: layer_state(11)})
+    }
+    assert diff_states(state, state) == []
+
+
+def test_diff_states_layers() -> None:
+    selected = layer_state(12)
+    selected = dataclasses.replace(
+        selected, info=dataclasses.replace(selected.info, selected=True)
+    )
+    before: ProjectState = {
+        1: ClipState(
+            "shot", {10: layer_state(10), 11: layer_state(11), 12: layer_state(12)}
+        ),
+        2: ClipState("removed", {20: layer_state(20)}),
+    }
+    after: ProjectState = {
+        1: ClipState(
+            "shot",
+            {10: layer_state(10, name="renamed"), 12: selected, 13: layer_state(13)},
+        ),
+    }
+
+    changes = diff_states(before, after)
+    assert [(c.kind, c.clip_id, c.layer_id) for c in changes] == [
+        (ChangeKind.CLIP_REMOVED, 2, None),
+        (ChangeKind.LAYER_REMOVED, 2, 20),
+        (ChangeKind.LAYER_REMOVED, 1, 11),
+        (ChangeKind.LAYER_RENAMED, 1, 10),
+        (ChangeKind.LAYER_ADDED, 1, 13),
+    ]
+    assert changes[3].before and changes[3].before.info.name == "layer"
+    assert changes[1].clip_name == "removed"
+
+
+def test_diff_states_clip_renamed() -> None:
+    before: ProjectState = {1: ClipState("shot", {10: layer_state(10)})}
+    after: ProjectState = {1: ClipState("renamed", {10: layer_state(10)})}
+
+    (change,) = diff_states(before, after)
+    assert change.kind == ChangeKind.CLIP_RENAMED
+    assert (change.clip_name, change.previous_clip_name) == ("renamed", "shot")
+
+
+def test_diff_states_instances() -> None:
+    before: ProjectState = {
+        1: ClipState("shot", {10: layer_state(10, starts=(0, 4, 8))})
+    }
+    after: ProjectState = {
+        1: ClipState("shot", {10: layer_state(10, starts=(0, 5, 8))})
+    }
+
+    (change,) = diff_states(before, after)
+    assert change.kind == ChangeKind.INSTANCES_CHANGED
+    assert change.added_starts == [5]
+    assert change.removed_starts == [4]
+
+
+def test_project_watcher_poll(mock_tvpaint: MockTVPaint) -> None:
+    layer_ids = respond_clip(mock_tvpaint, layer_count=3, frame_count=10)
+    layer_info = "ON 0 100 \"layer\" SEQUENCE 0 9 0 0 0 1 OFF"
+
+    def respond_layers(clip_name: str, last_frame: int = 9) -> None:
+        first_info = layer_info.replace(" 9 ", f" {last_frame} ")
+        mock_tvpaint.respond_script(
+            "tv_LayerInfo layer_id",
+            [f"clip 1 1 {clip_name}", f"{layer_ids[0]} 0 {first_info}"]
+            + [f"{layer_id} 0 {layer_info}" for layer_id in layer_ids[1:]],
+        )
+
+    enumerated: list[list[str]] = []
+
+    def exposures(source: str) -> list[str]:
+        layers = re.findall(r"tv_LayerSet (\d+)", source)
+        enumerated.append(layers)
+        return [f"{layer_id} {frame}" for layer_id in layers for frame in (0, 5)]
+
+    respond_layers("shot")
+    mock_tvpaint.respond_script("tv_ExposureNext", exposures)
+    watcher = ProjectWatcher(Project("7"))
+
+    changes = watcher.poll()
+    assert [c.kind for c in changes].count(ChangeKind.LAYER_ADDED) == 3
+    assert watcher.state[1].name == "shot"
+    assert watcher.state[1].layers[layer_ids[0]].instance_starts == (0, 5)
+
+    # The current project, the layers and the start frame, the instances are kept
+    mock_tvpaint.reset_stats()
+    assert watcher.poll() == []
+    assert mock_tvpaint.requests == 3
+    assert len(enumerated) == 1
+
+    # Only the instances of the changed layer are enumerated
+    respond_layers("renamed", last_frame=19)
+    changes = watcher.poll()
+    assert [(c.kind, c.layer_id) for c in changes] == [
+        (ChangeKind.CLIP_RENAMED, None),
+        (ChangeKind.LAYER_CHANGED, layer_ids[0]),
+    ]
+    assert enumerated[-1] == [str(layer_ids[0])]
+
+    assert watcher.poll(full=True) == []
+    assert enumerated[-1] == [str(layer_id) for layer_id in layer_ids]